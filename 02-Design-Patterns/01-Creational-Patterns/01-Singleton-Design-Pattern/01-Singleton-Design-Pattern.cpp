@@ -1,9 +1,12 @@
 #include <iostream>
+#include <atomic>
+#include <mutex>
 using namespace std;
 
 class Singleton {
 private:
-    static Singleton* instance; // static pointer to single instance
+    static atomic<Singleton*> instance; // static pointer to single instance
+    static mutex initMutex;             // guards the one-time creation only
     Singleton() {               // private constructor
         cout << "Singleton Instance Created\n";
     }
@@ -13,11 +16,19 @@ public:
     Singleton(const Singleton&) = delete;
     Singleton& operator=(const Singleton&) = delete;
 
+    // Double-checked locking: after the first call this is a single acquire load,
+    // the mutex is only taken while the instance is still being created.
     static Singleton* getInstance() {
-        if (instance == nullptr) {
-            instance = new Singleton();
+        Singleton* p = instance.load(memory_order_acquire);
+        if (p == nullptr) {
+            lock_guard<mutex> lock(initMutex);
+            p = instance.load(memory_order_relaxed);
+            if (p == nullptr) {
+                p = new Singleton();
+                instance.store(p, memory_order_release);
+            }
         }
-        return instance;
+        return p;
     }
 
     void showMessage() {
@@ -26,7 +37,8 @@ public:
 };
 
 // Initialize static member
-Singleton* Singleton::instance = nullptr;
+atomic<Singleton*> Singleton::instance{nullptr};
+mutex Singleton::initMutex;
 
 int main() {
     Singleton* s1 = Singleton::getInstance();
@@ -0,0 +1,168 @@
+/*
+    🧵 Thread-Safe Singleton — three ways to write getInstance()
+
+    The naive version
+        if (instance == nullptr) instance = new Singleton();
+    is a data race: two threads can both see nullptr and both create an object.
+
+    We compare three safe versions:
+        1. DoubleCheckedSingleton  → atomic pointer + mutex (only locked during creation)
+        2. CallOnceSingleton       → std::call_once + once_flag
+        3. MeyersSingleton         → function-local static (C++11 guarantees thread-safe init)
+
+    Once the instance exists, none of them takes a lock.
+    Nothing is written to shared memory after init, so the cache line holding the
+    pointer stays in "shared" state on every core → no cache-line ping-pong.
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 02-Thread-Safe-Singleton.cpp -o singleton && ./singleton
+*/
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+using namespace std;
+
+// 1️⃣ Double-checked locking with an atomic pointer
+class DoubleCheckedSingleton {
+private:
+    static atomic<DoubleCheckedSingleton*> instance;
+    static mutex initMutex;
+    DoubleCheckedSingleton() {}
+
+public:
+    DoubleCheckedSingleton(const DoubleCheckedSingleton&) = delete;
+    DoubleCheckedSingleton& operator=(const DoubleCheckedSingleton&) = delete;
+
+    static DoubleCheckedSingleton* getInstance() {
+        DoubleCheckedSingleton* p = instance.load(memory_order_acquire); // fast path
+        if (p == nullptr) {
+            lock_guard<mutex> lock(initMutex);
+            p = instance.load(memory_order_relaxed);                       // re-check under lock
+            if (p == nullptr) {
+                p = new DoubleCheckedSingleton();
+                instance.store(p, memory_order_release);
+            }
+        }
+        return p;
+    }
+};
+
+atomic<DoubleCheckedSingleton*> DoubleCheckedSingleton::instance{nullptr};
+mutex DoubleCheckedSingleton::initMutex;
+
+// 2️⃣ std::call_once
+class CallOnceSingleton {
+private:
+    static CallOnceSingleton* instance;
+    static once_flag initFlag;
+    CallOnceSingleton() {}
+
+public:
+    CallOnceSingleton(const CallOnceSingleton&) = delete;
+    CallOnceSingleton& operator=(const CallOnceSingleton&) = delete;
+
+    static CallOnceSingleton* getInstance() {
+        call_once(initFlag, [] { instance = new CallOnceSingleton(); });
+        return instance;
+    }
+};
+
+CallOnceSingleton* CallOnceSingleton::instance = nullptr;
+once_flag CallOnceSingleton::initFlag;
+
+// 3️⃣ Meyers Singleton (function-local static)
+class MeyersSingleton {
+private:
+    MeyersSingleton() {}
+
+public:
+    MeyersSingleton(const MeyersSingleton&) = delete;
+    MeyersSingleton& operator=(const MeyersSingleton&) = delete;
+
+    static MeyersSingleton* getInstance() {
+        static MeyersSingleton instance; // compiler inserts a guarded, thread-safe init
+        return &instance;
+    }
+};
+
+/*
+    🔹 Benchmark
+    Every thread calls getInstance() in a tight loop and checks it always gets the same
+    pointer. We report total calls/sec for 1..64 threads. If throughput grows (or stays flat
+    per core) as threads are added, there is no contention after init.
+*/
+
+template <typename T>
+double measure(int threads, long callsPerThread) {
+    T* expected = T::getInstance(); // make sure init is done before timing
+    atomic<long> mismatches{0};
+    atomic<bool> start{false};
+    vector<thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            while (!start.load(memory_order_acquire)) this_thread::yield();
+            long bad = 0;
+            for (long i = 0; i < callsPerThread; i++) {
+                T* p = T::getInstance();
+                asm volatile("" : : "r"(p) : "memory"); // keep the call inside the loop
+                if (p != expected) bad++;
+            }
+            mismatches += bad;
+        });
+    }
+
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+
+    if (mismatches) cout << "  !! " << mismatches << " calls returned a different instance\n";
+    double seconds = chrono::duration<double>(end - begin).count();
+    return threads * callsPerThread / seconds;
+}
+
+template <typename T>
+void runBenchmark(const string& name) {
+    const long callsPerThread = 2000000;
+    cout << name << endl;
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        double rate = measure<T>(threads, callsPerThread);
+        cout << "  threads=" << threads << "\t" << rate / 1e6 << " M calls/sec\n";
+    }
+}
+
+int main() {
+    // Race at startup: many threads ask for the instance at the same time.
+    vector<thread> racers;
+    atomic<DoubleCheckedSingleton*> seen[16];
+    for (int i = 0; i < 16; i++) {
+        racers.emplace_back([&, i] { seen[i] = DoubleCheckedSingleton::getInstance(); });
+    }
+    for (auto& r : racers) r.join();
+    bool same = true;
+    for (int i = 1; i < 16; i++) same = same && (seen[i].load() == seen[0].load());
+    cout << "16 racing threads got the same instance: " << (same ? "yes" : "NO") << "\n\n";
+
+    runBenchmark<DoubleCheckedSingleton>("DoubleCheckedSingleton (atomic + mutex)");
+    runBenchmark<CallOnceSingleton>("CallOnceSingleton (std::call_once)");
+    runBenchmark<MeyersSingleton>("MeyersSingleton (local static)");
+
+    return 0;
+}
+
+/*
+    ✅ Takeaways
+        - All three are safe and none of them writes shared memory after init.
+        - Double-checked and Meyers are a single load + branch on the fast path.
+          call_once is an out-of-line call (pthread_once on glibc), so it is a few times
+          slower per call — still contention-free, just more instructions.
+        - Prefer the Meyers Singleton: shortest code, the compiler does the locking.
+        - Use double-checked locking only when you need control over when/how the
+          instance is created (e.g. passing config, or explicit destruction).
+*/
@@ -0,0 +1,179 @@
+/*
+    🧩 Sharded Singleton — one logical instance, one physical copy per thread
+
+    A Singleton is one object shared by everyone. That is fine for read-mostly things
+    (config, logger handle), but as soon as the instance holds mutable state that every
+    request updates (counters, small caches), every core writes the same cache line.
+    The line bounces between cores and throughput goes down as threads are added.
+
+    Idea:
+        - Keep the Singleton API (getInstance()) so the rest of the code does not change.
+        - Internally keep N shards, each on its own cache line.
+        - Each thread writes only to "its" shard (local()).
+        - Readers call aggregate() to merge all shards into one answer.
+
+    Writes become core-local → counters scale with cores.
+    Reads pay an O(N) merge → use it where writes are hot and reads are rare (metrics, stats).
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 03-Sharded-Singleton.cpp -o sharded && ./sharded
+*/
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+using namespace std;
+
+// Size of a cache line on x86-64 / most ARM cores
+constexpr size_t CACHE_LINE = 64;
+
+/*
+    🔹 Step 1: The ShardedSingleton template
+    T is the per-shard state. Shards are padded to a full cache line so two threads never
+    write the same line (no false sharing).
+*/
+template <typename T, size_t Shards = 64>
+class ShardedSingleton {
+private:
+    struct alignas(CACHE_LINE) Shard {
+        T value{};
+    };
+
+    Shard shards[Shards];
+    atomic<size_t> nextSlot{0};
+
+    ShardedSingleton() {}
+
+public:
+    ShardedSingleton(const ShardedSingleton&) = delete;
+    ShardedSingleton& operator=(const ShardedSingleton&) = delete;
+
+    static ShardedSingleton& getInstance() {
+        static ShardedSingleton instance; // thread-safe init (Meyers)
+        return instance;
+    }
+
+    // Shard owned by the calling thread. Slot is picked once per thread.
+    // With more threads than shards, a few threads share a shard — T must tolerate that
+    // (e.g. use relaxed atomics as below).
+    T& local() {
+        thread_local size_t slot = nextSlot.fetch_add(1, memory_order_relaxed) % Shards;
+        return shards[slot].value;
+    }
+
+    // Merge all shards for readers: result = fn(result, shard) for each shard.
+    template <typename R, typename Fn>
+    R aggregate(R init, Fn fn) const {
+        for (size_t i = 0; i < Shards; i++) init = fn(init, shards[i].value);
+        return init;
+    }
+};
+
+/*
+    🔹 Step 2: The state we want to shard — request metrics
+    Relaxed atomics: the owning thread's increment is an uncontended RMW on its own line,
+    and aggregate() can read concurrently without a data race.
+*/
+struct RequestStats {
+    atomic<long> requests{0};
+    atomic<long> bytes{0};
+
+    void record(long size) {
+        requests.fetch_add(1, memory_order_relaxed);
+        bytes.fetch_add(size, memory_order_relaxed);
+    }
+};
+
+struct Totals {
+    long requests = 0;
+    long bytes = 0;
+};
+
+using ShardedStats = ShardedSingleton<RequestStats>;
+
+/*
+    🔹 Step 3: The plain Singleton we compare against — one RequestStats for everybody
+*/
+class PlainStats {
+private:
+    RequestStats stats;
+    PlainStats() {}
+
+public:
+    PlainStats(const PlainStats&) = delete;
+    PlainStats& operator=(const PlainStats&) = delete;
+
+    static PlainStats& getInstance() {
+        static PlainStats instance;
+        return instance;
+    }
+
+    void record(long size) { stats.record(size); }
+    Totals total() const { return {stats.requests.load(), stats.bytes.load()}; }
+};
+
+/*
+    🔹 Step 4: Write-heavy benchmark
+    Each thread records `ops` requests. We measure total updates/sec.
+*/
+template <typename Work>
+double runThreads(int threads, long ops, Work work) {
+    atomic<bool> start{false};
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            while (!start.load(memory_order_acquire)) this_thread::yield();
+            for (long i = 0; i < ops; i++) work(i);
+        });
+    }
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    return threads * ops / chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+    const long ops = 2000000;
+    unsigned cores = thread::hardware_concurrency();
+    cout << "hardware threads: " << cores << "\n\n";
+
+    long expectedRequests = 0;
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        expectedRequests += threads * ops;
+
+        double plain = runThreads(threads, ops, [](long i) {
+            PlainStats::getInstance().record(i & 1023);
+        });
+        double sharded = runThreads(threads, ops, [](long i) {
+            ShardedStats::getInstance().local().record(i & 1023);
+        });
+
+        cout << "threads=" << threads
+             << "\tplain: " << plain / 1e6 << " M ops/s"
+             << "\tsharded: " << sharded / 1e6 << " M ops/s\n";
+    }
+
+    // Readers merge the shards — both must agree on the totals.
+    Totals merged = ShardedStats::getInstance().aggregate(Totals{}, [](Totals acc, const RequestStats& s) {
+        acc.requests += s.requests.load(memory_order_relaxed);
+        acc.bytes += s.bytes.load(memory_order_relaxed);
+        return acc;
+    });
+    Totals single = PlainStats::getInstance().total();
+
+    cout << "\nexpected requests: " << expectedRequests << endl;
+    cout << "plain   total: " << single.requests << " requests, " << single.bytes << " bytes\n";
+    cout << "sharded total: " << merged.requests << " requests, " << merged.bytes << " bytes\n";
+    return 0;
+}
+
+/*
+    ✅ Takeaways
+        - On one core both versions run at the same speed (there is nobody to contend with).
+        - On many cores the plain Singleton flattens or drops; the sharded one grows ~linearly.
+        - Cost: memory (Shards × 64 bytes) and an O(Shards) aggregate() on the read side.
+*/
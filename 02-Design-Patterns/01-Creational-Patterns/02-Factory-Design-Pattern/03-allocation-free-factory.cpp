@@ -0,0 +1,300 @@
+/*
+    ⚡ Allocation-Free Factory with a Compile-Time Registry
+
+    The Simple Factory from 01-factory-design-pattern.cpp:
+
+        static Payment* createPayment(string type) {
+            if (type == "creditcard") return new CreditCardPayment();
+            else if (type == "paypal") return new PayPalPayment();
+            ...
+        }
+
+    has two costs on a hot path (checkout creates millions of payments a day):
+        ❌ Lookup is a chain of string compares → O(number of types)
+        ❌ Every payment is a heap allocation (new/delete)
+
+    🔹 Fix
+        1. Hash every registered name at compile time (constexpr FNV-1a) and build an
+           open-addressing table from them, also at compile time.
+           Runtime lookup = hash the input once + probe the table → O(1).
+        2. Construct the object with placement new inside a small buffer owned by a
+           PaymentHandle (lives on the caller's stack). No new/delete at all.
+
+    Build & run:
+        g++ -std=c++17 -O2 03-allocation-free-factory.cpp -o factory && ./factory
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+// 1️⃣ Product Interface (same as before)
+class Payment {
+public:
+    virtual void pay(int amount) = 0;
+    virtual ~Payment() = default;
+};
+
+// 2️⃣ Concrete Products
+class CreditCardPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using Credit Card.\n";
+    }
+};
+
+class PayPalPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using PayPal.\n";
+    }
+};
+
+class UPIPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using UPI.\n";
+    }
+};
+
+/*
+    🔹 Step 1: Compile-time string hashing
+*/
+constexpr uint64_t hashName(string_view s) {
+    uint64_t h = 1469598103934665603ull;    // FNV-1a offset basis
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;              // FNV-1a prime
+    }
+    return h;
+}
+
+// Fixed-size name stored inside the table (so the table is a pure constexpr value)
+struct FixedName {
+    char data[24] = {};
+    size_t len = 0;
+
+    constexpr FixedName() {}
+    constexpr FixedName(string_view s) {
+        if (s.size() > sizeof(data)) throw "payment type name longer than 24 characters"; // compile error in constexpr
+        for (size_t i = 0; i < s.size(); i++) data[i] = s[i];
+        len = s.size();
+    }
+    constexpr string_view view() const { return string_view(data, len); }
+};
+
+/*
+    🔹 Step 2: PaymentHandle — small-buffer owner, replaces Payment* + delete
+    The object lives inside `buffer`. The destructor runs ~Payment() in place.
+*/
+class PaymentHandle {
+public:
+    static constexpr size_t Capacity = 32;
+
+private:
+    alignas(max_align_t) unsigned char buffer[Capacity];
+    Payment* ptr = nullptr;
+
+public:
+    PaymentHandle() {}
+    PaymentHandle(const PaymentHandle&) = delete;
+    PaymentHandle& operator=(const PaymentHandle&) = delete;
+    ~PaymentHandle() { reset(); }
+
+    template <typename T>
+    void emplace() {
+        static_assert(sizeof(T) <= Capacity, "Payment type too large for PaymentHandle");
+        static_assert(alignof(T) <= alignof(max_align_t), "Payment type over-aligned");
+        reset();
+        ptr = new (buffer) T();
+    }
+
+    void reset() {
+        if (ptr) {
+            ptr->~Payment();
+            ptr = nullptr;
+        }
+    }
+
+    explicit operator bool() const { return ptr != nullptr; }
+    Payment* operator->() const { return ptr; }
+    Payment& operator*() const { return *ptr; }
+};
+
+/*
+    🔹 Step 3: The registry
+    Each entry knows its name, its hash and how to construct itself into a handle.
+    The table size is the next power of two ≥ 2 × entries, so linear probing is short.
+*/
+using CreateFn = void (*)(PaymentHandle&);
+
+template <typename T>
+void constructInto(PaymentHandle& handle) { handle.emplace<T>(); }
+
+struct RegistryEntry {
+    uint64_t hash = 0;
+    FixedName name;
+    CreateFn create = nullptr;
+};
+
+template <typename T>
+constexpr RegistryEntry registerPayment(string_view name) {
+    return RegistryEntry{hashName(name), FixedName(name), &constructInto<T>};
+}
+
+constexpr size_t tableSizeFor(size_t n) {
+    size_t size = 1;
+    while (size < 2 * n) size *= 2;
+    return size;
+}
+
+template <size_t N>
+class PaymentRegistry {
+    static constexpr size_t Size = tableSizeFor(N);
+    static constexpr size_t Mask = Size - 1;
+    array<RegistryEntry, Size> slots{};
+
+public:
+    // Runs at compile time when the registry is declared constexpr.
+    constexpr PaymentRegistry(const array<RegistryEntry, N>& entries) {
+        for (const RegistryEntry& e : entries) {
+            size_t i = e.hash & Mask;
+            while (slots[i].create != nullptr) {
+                if (slots[i].name.view() == e.name.view())
+                    throw "duplicate payment type registered"; // compile error in constexpr
+                i = (i + 1) & Mask;
+            }
+            slots[i] = e;
+        }
+    }
+
+    // O(1): one hash of the input, a short probe, one final compare to reject collisions.
+    bool create(string_view type, PaymentHandle& out) const {
+        uint64_t h = hashName(type);
+        for (size_t i = h & Mask; slots[i].create != nullptr; i = (i + 1) & Mask) {
+            if (slots[i].hash == h && slots[i].name.view() == type) {
+                slots[i].create(out);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <size_t N>
+PaymentRegistry(const array<RegistryEntry, N>&) -> PaymentRegistry<N>;
+
+// ✅ The factory — whole table is computed by the compiler
+class PaymentFactory {
+    static constexpr PaymentRegistry<3> registry{array<RegistryEntry, 3>{
+        registerPayment<CreditCardPayment>("creditcard"),
+        registerPayment<PayPalPayment>("paypal"),
+        registerPayment<UPIPayment>("upi"),
+    }};
+
+public:
+    static bool createPayment(string_view type, PaymentHandle& out) {
+        return registry.create(type, out);
+    }
+};
+
+/*
+    -------------------------------------------------------------------------------------
+    🔹 Benchmark setup: N synthetic gateways "gateway_0" .. "gateway_{N-1}"
+    -------------------------------------------------------------------------------------
+*/
+long long benchSink = 0;
+
+template <size_t I>
+class GatewayPayment : public Payment {
+public:
+    void pay(int amount) override { benchSink += amount + static_cast<long long>(I); }
+};
+
+constexpr FixedName gatewayName(size_t i) {
+    FixedName n("gateway_");
+    char digits[8] = {};
+    size_t d = 0;
+    do { digits[d++] = static_cast<char>('0' + i % 10); i /= 10; } while (i > 0);
+    if (n.len + d > sizeof(n.data)) throw "gateway name longer than 24 characters";
+    while (d > 0) n.data[n.len++] = digits[--d];
+    return n;
+}
+
+template <size_t I>
+constexpr FixedName gatewayNameOf = gatewayName(I);
+
+template <size_t... I>
+constexpr array<RegistryEntry, sizeof...(I)> gatewayEntries(index_sequence<I...>) {
+    return {registerPayment<GatewayPayment<I>>(gatewayName(I).view())...};
+}
+
+template <size_t N>
+constexpr PaymentRegistry<N> gatewayRegistry{gatewayEntries(make_index_sequence<N>{})};
+
+// Baseline: the original if/else chain with new, expanded for N types
+template <size_t... I>
+Payment* createByStringChain(string type, index_sequence<I...>) {
+    Payment* p = nullptr;
+    ((type == gatewayNameOf<I>.view() ? (p = new GatewayPayment<I>(), true) : false) || ...);
+    return p;
+}
+
+template <size_t N>
+void runBenchmark() {
+    const int ops = 1000000;
+    mt19937 rng(42);
+    uniform_int_distribution<size_t> pick(0, N - 1);
+    vector<string> keys;
+    for (int i = 0; i < 4096; i++) keys.push_back(string(gatewayName(pick(rng)).view()));
+
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        Payment* p = createByStringChain(keys[i & 4095], make_index_sequence<N>{});
+        p->pay(i);
+        delete p;
+    }
+    auto t1 = chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        PaymentHandle handle;
+        gatewayRegistry<N>.create(keys[i & 4095], handle);
+        handle->pay(i);
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    double chainNs = chrono::duration<double, nano>(t1 - t0).count() / ops;
+    double registryNs = chrono::duration<double, nano>(t2 - t1).count() / ops;
+    cout << "types=" << N << "\tstring chain + new: " << chainNs << " ns/op"
+         << "\tconstexpr registry + handle: " << registryNs << " ns/op\n";
+}
+
+// 🧠 Client code
+int main() {
+    PaymentHandle payment;
+    if (PaymentFactory::createPayment("upi", payment)) payment->pay(1000);
+    if (PaymentFactory::createPayment("paypal", payment)) payment->pay(2000);
+    if (!PaymentFactory::createPayment("bitcoin", payment)) cout << "Invalid payment type.\n";
+
+    cout << "\nBenchmark (create + pay + destroy):\n";
+    runBenchmark<3>();
+    runBenchmark<30>();
+    runBenchmark<300>();
+    cout << "(sink " << benchSink << ")\n";
+}
+
+/*
+    ✅ Result
+        - The string chain gets slower as types are added; the registry stays flat.
+        - No heap traffic: the payment object lives in the handle on the stack.
+        - Adding a type = one registerPayment<T>("name") line. A duplicate name or a type
+          larger than PaymentHandle::Capacity fails to compile.
+*/
@@ -0,0 +1,266 @@
+/*
+    📦 Batched Payments — one virtual call for thousands of transactions
+
+    In Step 3 of 01-factory-design-pattern.cpp every transaction costs:
+        PaymentProcessor::process(amount)
+            → createPayment()   (new)
+            → pay(amount)       (virtual call, one amount)
+            → delete
+    Per-transaction overhead dominates the actual work (validate, apply limit, add fee).
+
+    🔹 Batched API
+        Payment::payBatch(AmountSpan)            → validates + sums a whole array
+        PaymentProcessor::processBatch(AmountSpan) → creates the Payment ONCE per batch
+
+    The work per transaction is now a tight loop over a contiguous int32 array, which the
+    CPU can do 8 at a time with AVX2. A scalar kernel is kept as the fallback and as the
+    reference the SIMD kernel is checked against.
+
+    Rules applied per amount (per gateway policy):
+        valid    → 0 < amount <= limit
+        accepted → count and sum of valid amounts
+        fees     → accepted × fixedFee + acceptedTotal × feeBps / 10000
+
+    Build & run:
+        g++ -std=c++17 -O2 04-batched-payment.cpp -o batch && ./batch
+    (AVX2 is picked at runtime when the CPU supports it.)
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstddef>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#endif
+using namespace std;
+
+using Amount = int32_t; // minor currency units (paise / cents)
+
+// Minimal read-only view over contiguous amounts (std::span<const Amount> in C++20)
+struct AmountSpan {
+    const Amount* data;
+    size_t size;
+    AmountSpan(const Amount* d, size_t n) : data(d), size(n) {}
+    AmountSpan(const vector<Amount>& v) : data(v.data()), size(v.size()) {}
+};
+
+struct BatchResult {
+    int64_t accepted = 0;
+    int64_t rejected = 0;
+    int64_t acceptedTotal = 0;
+    int64_t fees = 0;
+};
+
+struct GatewayPolicy {
+    Amount limit;      // max single transaction
+    int64_t fixedFee;  // per accepted transaction
+    int64_t feeBps;    // basis points on accepted volume
+};
+
+/*
+    🔹 Step 1: Kernels
+*/
+struct KernelSums {
+    int64_t count = 0;
+    int64_t total = 0;
+};
+
+// Scalar reference kernel
+KernelSums sumValidScalar(const Amount* a, size_t n, Amount limit) {
+    KernelSums s;
+    for (size_t i = 0; i < n; i++) {
+        bool ok = a[i] > 0 && a[i] <= limit;
+        s.count += ok;
+        s.total += ok ? a[i] : 0;
+    }
+    return s;
+}
+
+#ifdef HAVE_AVX2_KERNEL
+// AVX2 kernel: 8 amounts per iteration, branch-free
+__attribute__((target("avx2,popcnt")))
+KernelSums sumValidAvx2(const Amount* a, size_t n, Amount limit) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lim = _mm256_set1_epi32(limit);
+    __m256i total = _mm256_setzero_si256(); // 4 × int64 lanes
+    int64_t count = 0;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i positive = _mm256_cmpgt_epi32(v, zero);                 // v > 0
+        __m256i overLimit = _mm256_cmpgt_epi32(v, lim);                 // v > limit
+        __m256i valid = _mm256_andnot_si256(overLimit, positive);       // 0 < v <= limit
+        count += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(valid))));
+
+        __m256i kept = _mm256_and_si256(v, valid);
+        // widen to int64 before adding so large batches cannot overflow
+        total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(kept)));
+        total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(kept, 1)));
+    }
+
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+    KernelSums tail = sumValidScalar(a + i, n - i, limit);
+    return {count + tail.count, lanes[0] + lanes[1] + lanes[2] + lanes[3] + tail.total};
+}
+#endif
+
+using SumKernel = KernelSums (*)(const Amount*, size_t, Amount);
+
+SumKernel selectKernel() {
+#ifdef HAVE_AVX2_KERNEL
+    if (__builtin_cpu_supports("avx2")) return sumValidAvx2;
+#endif
+    return sumValidScalar;
+}
+
+SumKernel activeKernel = selectKernel();
+
+/*
+    🔹 Step 2: Product Interface with a batch method
+*/
+class Payment {
+public:
+    virtual void pay(int amount) = 0;
+    virtual BatchResult payBatch(AmountSpan amounts) = 0;
+    virtual ~Payment() = default;
+
+protected:
+    static BatchResult settle(AmountSpan amounts, const GatewayPolicy& policy) {
+        KernelSums s = activeKernel(amounts.data, amounts.size, policy.limit);
+        BatchResult r;
+        r.accepted = s.count;
+        r.rejected = static_cast<int64_t>(amounts.size) - s.count;
+        r.acceptedTotal = s.total;
+        r.fees = s.count * policy.fixedFee + s.total * policy.feeBps / 10000;
+        return r;
+    }
+};
+
+// Concrete Products
+class CreditCardPayment : public Payment {
+    static constexpr GatewayPolicy policy{200000, 3, 180}; // 1.8% + 3
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using Credit Card.\n";
+    }
+    BatchResult payBatch(AmountSpan amounts) override { return settle(amounts, policy); }
+};
+
+class PayPalPayment : public Payment {
+    static constexpr GatewayPolicy policy{100000, 5, 290}; // 2.9% + 5
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using PayPal.\n";
+    }
+    BatchResult payBatch(AmountSpan amounts) override { return settle(amounts, policy); }
+};
+
+class UPIPayment : public Payment {
+    static constexpr GatewayPolicy policy{100000, 0, 0}; // no fee, 1 lakh limit
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using UPI.\n";
+    }
+    BatchResult payBatch(AmountSpan amounts) override { return settle(amounts, policy); }
+};
+
+/*
+    🔹 Step 3: Factory Base (Creator) with processBatch
+*/
+class PaymentProcessor {
+public:
+    virtual Payment* createPayment() = 0;  // Factory Method
+    void process(int amount) {
+        Payment* p = createPayment();
+        p->pay(amount);
+        delete p;
+    }
+    // One create + one virtual call per batch instead of per transaction
+    BatchResult processBatch(AmountSpan amounts) {
+        Payment* p = createPayment();
+        BatchResult r = p->payBatch(amounts);
+        delete p;
+        return r;
+    }
+    virtual ~PaymentProcessor() = default;
+};
+
+class CreditCardProcessor : public PaymentProcessor {
+public:
+    Payment* createPayment() override { return new CreditCardPayment(); }
+};
+
+class PayPalProcessor : public PaymentProcessor {
+public:
+    Payment* createPayment() override { return new PayPalPayment(); }
+};
+
+class UPIProcessor : public PaymentProcessor {
+public:
+    Payment* createPayment() override { return new UPIPayment(); }
+};
+
+/*
+    🔹 Step 4: Benchmark — single core, batch sizes 1 .. 65536
+*/
+double measure(PaymentProcessor& processor, const vector<Amount>& amounts, size_t batch, int64_t& checksum) {
+    const size_t total = amounts.size();
+    auto begin = chrono::steady_clock::now();
+    for (size_t off = 0; off + batch <= total; off += batch) {
+        checksum += processor.processBatch(AmountSpan(amounts.data() + off, batch)).fees;
+    }
+    auto end = chrono::steady_clock::now();
+    return (total / batch) * batch / chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+    PaymentProcessor* processor = new PayPalProcessor();
+    processor->process(2000);
+
+    vector<Amount> sample = {500, -10, 250000, 99999, 0, 1200};
+    BatchResult r = processor->processBatch(sample);
+    cout << "Batch: accepted " << r.accepted << ", rejected " << r.rejected
+         << ", volume " << r.acceptedTotal << ", fees " << r.fees << "\n\n";
+
+    // Random amounts, ~10% invalid (≤ 0 or over the limit)
+    const size_t N = 1 << 22;
+    vector<Amount> amounts(N);
+    mt19937 rng(7);
+    uniform_int_distribution<Amount> dist(-5000, 110000);
+    for (Amount& a : amounts) a = dist(rng);
+
+    // SIMD and scalar must agree
+    KernelSums ref = sumValidScalar(amounts.data(), N, 100000);
+    KernelSums fast = activeKernel(amounts.data(), N, 100000);
+    cout << "kernel: " << (activeKernel == sumValidScalar ? "scalar" : "avx2")
+         << ", matches scalar: " << (ref.count == fast.count && ref.total == fast.total ? "yes" : "NO") << "\n";
+
+    int64_t checksum = 0;
+    SumKernel simd = activeKernel;
+    for (size_t batch = 1; batch <= 65536; batch *= 4) {
+        activeKernel = sumValidScalar;
+        double scalarRate = measure(*processor, amounts, batch, checksum);
+        activeKernel = simd;
+        double simdRate = measure(*processor, amounts, batch, checksum);
+        cout << "batch=" << batch << "\tscalar: " << scalarRate / 1e6 << " M txn/s"
+             << "\tsimd: " << simdRate / 1e6 << " M txn/s\n";
+    }
+    cout << "(checksum " << checksum << ")\n";
+
+    delete processor;
+}
+
+/*
+    ✅ Result
+        - batch=1 is the old cost model: one new/delete + one virtual call per transaction.
+        - As the batch grows, the fixed per-call cost is amortised and the kernel speed takes over.
+        - AVX2 processes 8 amounts per instruction group, so large batches run several times
+          faster than the scalar loop.
+*/
@@ -0,0 +1,306 @@
+/*
+    ♻️ Object Pool behind the Factory Method
+
+    PaymentProcessor::process() from 01-factory-design-pattern.cpp:
+
+        void process(int amount) {
+            Payment* p = createPayment();   // new
+            p->pay(amount);
+            delete p;                       // delete
+        }
+
+    puts the allocator on every transaction. The object is used once and thrown away,
+    even though the next transaction needs exactly the same kind of object.
+
+    🔹 Fix: keep used Payment objects in a pool and hand them out again
+        - One pool per thread per processor type → no locks, no sharing between cores
+        - createPayment() (the Factory Method) is still used, but only on a pool miss
+        - PooledPayment is an RAII handle: it gives the object back when it goes out of scope
+        - Counters: hits, misses, high-water mark (max objects in use at once)
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 05-pooled-payment-processor.cpp -o pool && ./pool
+*/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+using namespace std;
+
+// 1️⃣ Product Interface
+class Payment {
+public:
+    virtual void pay(int amount) = 0;
+    virtual void reset() {}            // called before the object goes back to the pool
+    virtual ~Payment() = default;
+};
+
+// 2️⃣ Concrete Products
+class CreditCardPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using Credit Card.\n";
+    }
+};
+
+class PayPalPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using PayPal.\n";
+    }
+};
+
+class UPIPayment : public Payment {
+public:
+    void pay(int amount) override {
+        cout << "Paid " << amount << " using UPI.\n";
+    }
+};
+
+/*
+    🔹 Step 1: Pool statistics
+    Each thread counts in its own pool (plain integers, no atomics on the hot path) and
+    publishes the numbers into the global totals when the thread exits.
+*/
+struct PoolStats {
+    long hits = 0;
+    long misses = 0;
+    long highWater = 0;
+};
+
+class PoolStatsRegistry {
+    mutex m;
+    PoolStats totals;
+    PoolStatsRegistry() {}
+
+public:
+    static PoolStatsRegistry& getInstance() {
+        static PoolStatsRegistry instance;
+        return instance;
+    }
+
+    void publish(const PoolStats& s) {
+        lock_guard<mutex> lock(m);
+        totals.hits += s.hits;
+        totals.misses += s.misses;
+        totals.highWater = max(totals.highWater, s.highWater);
+    }
+
+    PoolStats snapshot() {
+        lock_guard<mutex> lock(m);
+        return totals;
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(m);
+        totals = PoolStats();
+    }
+};
+
+class PaymentProcessor;
+
+/*
+    🔹 Step 2: The pool (single-thread owner)
+*/
+class PaymentPool {
+    vector<Payment*> idle;
+    size_t maxIdle;
+    long inUse = 0;
+    PoolStats stats;
+
+public:
+    explicit PaymentPool(size_t maxIdle = 64) : maxIdle(maxIdle) {}
+    PaymentPool(const PaymentPool&) = delete;
+    PaymentPool& operator=(const PaymentPool&) = delete;
+
+    ~PaymentPool() {
+        for (Payment* p : idle) delete p;
+        PoolStatsRegistry::getInstance().publish(stats);
+    }
+
+    Payment* acquire(PaymentProcessor& factory);
+
+    void release(Payment* p) {
+        inUse--;
+        if (idle.size() < maxIdle) {
+            p->reset();
+            idle.push_back(p);
+        } else {
+            delete p; // pool is full — bound the memory we keep around
+        }
+    }
+
+    const PoolStats& localStats() const { return stats; }
+};
+
+// RAII handle — returns the object to its pool on scope exit
+class PooledPayment {
+    PaymentPool* pool;
+    Payment* payment;
+
+public:
+    PooledPayment(PaymentPool& pool, Payment* p) : pool(&pool), payment(p) {}
+    PooledPayment(PooledPayment&& other) noexcept : pool(other.pool), payment(other.payment) {
+        other.payment = nullptr;
+    }
+    PooledPayment(const PooledPayment&) = delete;
+    PooledPayment& operator=(const PooledPayment&) = delete;
+    PooledPayment& operator=(PooledPayment&&) = delete;
+    ~PooledPayment() {
+        if (payment) pool->release(payment);
+    }
+
+    Payment* operator->() const { return payment; }
+};
+
+/*
+    🔹 Step 3: Factory Base (Creator) — process() now borrows from the pool
+*/
+class PaymentProcessor {
+public:
+    virtual Payment* createPayment() = 0;  // Factory Method (used on pool miss)
+    virtual PaymentPool& localPool() = 0;  // this thread's pool for this processor type
+
+    PooledPayment borrowPayment() {
+        PaymentPool& pool = localPool();
+        return PooledPayment(pool, pool.acquire(*this));
+    }
+
+    void process(int amount) {
+        PooledPayment p = borrowPayment();
+        p->pay(amount);
+    }   // ← returned to the pool here
+
+    // Original version kept for comparison
+    void processUnpooled(int amount) {
+        Payment* p = createPayment();
+        p->pay(amount);
+        delete p;
+    }
+
+    virtual ~PaymentProcessor() = default;
+};
+
+Payment* PaymentPool::acquire(PaymentProcessor& factory) {
+    Payment* p;
+    if (!idle.empty()) {
+        p = idle.back();
+        idle.pop_back();
+        stats.hits++;
+    } else {
+        p = factory.createPayment();
+        stats.misses++;
+    }
+    inUse++;
+    if (inUse > stats.highWater) stats.highWater = inUse;
+    return p;
+}
+
+// Gives every concrete processor its own thread_local pool
+// (each Derived instantiates a separate localPool(), so each gets a separate pool)
+template <typename Derived>
+class PoolingProcessor : public PaymentProcessor {
+public:
+    PaymentPool& localPool() override {
+        thread_local PaymentPool pool;
+        return pool;
+    }
+};
+
+// 4️⃣ Concrete Factories
+class CreditCardProcessor : public PoolingProcessor<CreditCardProcessor> {
+public:
+    Payment* createPayment() override { return new CreditCardPayment(); }
+};
+
+class PayPalProcessor : public PoolingProcessor<PayPalProcessor> {
+public:
+    Payment* createPayment() override { return new PayPalPayment(); }
+};
+
+class UPIProcessor : public PoolingProcessor<UPIProcessor> {
+public:
+    Payment* createPayment() override { return new UPIPayment(); }
+};
+
+/*
+    -------------------------------------------------------------------------------------
+    🔹 Benchmark: a ledger payment that does real (non-printing) work per call
+    -------------------------------------------------------------------------------------
+*/
+class LedgerPayment : public Payment {
+    long balance = 0;
+    char reference[48] = {};   // makes the object a realistic size
+public:
+    void pay(int amount) override {
+        balance += amount;
+        reference[amount & 31] ^= static_cast<char>(amount);
+    }
+    void reset() override { balance = 0; }
+};
+
+class LedgerProcessor : public PoolingProcessor<LedgerProcessor> {
+public:
+    Payment* createPayment() override { return new LedgerPayment(); }
+};
+
+template <typename Work>
+double runThreads(int threads, long ops, Work work) {
+    atomic<bool> start{false};
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            while (!start.load(memory_order_acquire)) this_thread::yield();
+            for (long i = 0; i < ops; i++) work(static_cast<int>(i));
+        });
+    }
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    return threads * ops / chrono::duration<double>(end - begin).count();
+}
+
+// 5️⃣ Client Code
+int main() {
+    PaymentProcessor* processor = new PayPalProcessor();
+    processor->process(2000);
+    processor->process(3000);   // same object, reused
+    {
+        // two payments alive at once → one more miss, high-water = 2
+        PooledPayment a = processor->borrowPayment();
+        PooledPayment b = processor->borrowPayment();
+        a->pay(10);
+        b->pay(20);
+    }
+    const PoolStats& s = processor->localPool().localStats();
+    cout << "main thread pool: hits " << s.hits << ", misses " << s.misses
+         << ", high-water " << s.highWater << "\n\n";
+    delete processor;
+
+    LedgerProcessor ledger;
+    const long ops = 2000000;
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        PoolStatsRegistry::getInstance().clear();
+        double mallocRate = runThreads(threads, ops, [&](int amount) { ledger.processUnpooled(amount); });
+        double poolRate = runThreads(threads, ops, [&](int amount) { ledger.process(amount); });
+        PoolStats total = PoolStatsRegistry::getInstance().snapshot();
+        cout << "threads=" << threads
+             << "\tnew/delete (glibc malloc): " << mallocRate / 1e6 << " M/s"
+             << "\tpooled: " << poolRate / 1e6 << " M/s"
+             << "\t[hits " << total.hits << ", misses " << total.misses
+             << ", high-water " << total.highWater << "]\n";
+    }
+}
+
+/*
+    ✅ Result
+        - Misses == number of threads: each thread allocates once, then reuses forever.
+        - No locks and no shared cache lines on the hot path (pools are thread_local).
+        - glibc's tcache already makes small new/delete cheap; the pool still removes the
+          allocator call, the size-class lookup and the constructor/destructor work.
+*/
@@ -0,0 +1,368 @@
+/*
+    🔌 Example for 2️⃣ (continued) — a real Connection Pool built by the Factory
+
+    In 02-factory-design-pattern.cpp setPoolSize() and setTimeout() only print, and the
+    client opens + authenticates a brand new connection every time it needs the DB.
+    Connecting is the expensive part (TCP + TLS + auth round-trips), so paying it per
+    request puts the whole handshake latency on every request.
+
+    🔹 What the factory builds now
+        ConnectionPool
+            - pre-warms N authenticated connections at startup (setPoolSize)
+            - hands out leases from a lock-free free-list
+            - acquire() gives up after the configured timeout (setTimeout)
+            - a background thread pings idle connections one at a time and reconnects
+              broken ones; the rest of the pool stays available while it does
+        ConnectionLease
+            - RAII: the connection goes back to the pool when the lease is destroyed
+
+    FakeDatabaseServer stands in for a real DB: it sleeps for a configurable connect /
+    auth latency and can "drop" connections so the health checker has work to do.
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 06-connection-pool.cpp -o pool && ./pool
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/*
+    🔹 Step 1: In-process fake server
+*/
+class FakeDatabaseServer {
+    chrono::microseconds connectLatency;
+    chrono::microseconds authLatency;
+    atomic<long> handshakes{0};
+    atomic<uint64_t> dropEpoch{0};   // connections opened before this epoch are dead
+
+public:
+    FakeDatabaseServer(chrono::microseconds connect, chrono::microseconds auth)
+        : connectLatency(connect), authLatency(auth) {}
+
+    uint64_t connect(const string& host, int port) {
+        if (host.empty() || port <= 0 || port > 65535) throw invalid_argument("bad database address");
+        this_thread::sleep_for(connectLatency);
+        handshakes++;
+        return dropEpoch.load();
+    }
+
+    bool authenticate(const string& user, const string& password) {
+        this_thread::sleep_for(authLatency);
+        return !user.empty() && !password.empty();
+    }
+
+    bool isAlive(uint64_t openedAtEpoch) const { return openedAtEpoch == dropEpoch.load(); }
+    void dropAllConnections() { dropEpoch++; }   // simulate a failover / network blip
+    long handshakeCount() const { return handshakes.load(); }
+};
+
+/*
+    🔹 Step 2: The product — now it actually talks to the server
+*/
+class DatabaseConnection {
+    FakeDatabaseServer& server;
+    string host;
+    int port;
+    uint64_t epoch = 0;
+    bool authenticated = false;
+
+public:
+    DatabaseConnection(FakeDatabaseServer& server, string host, int port)
+        : server(server), host(move(host)), port(port) {
+        epoch = server.connect(this->host, port);
+    }
+
+    void authenticate(const string& user, const string& password) {
+        authenticated = server.authenticate(user, password);
+    }
+
+    bool ping() const { return authenticated && server.isAlive(epoch); }
+
+    void reconnect(const string& user, const string& password) {
+        epoch = server.connect(host, port);
+        authenticate(user, password);
+    }
+
+    int query(int id) const { return id * 2; } // stand-in for real work
+};
+
+/*
+    🔹 Step 3: The pool
+    Free-list = Treiber stack over slot indices. The head packs {tag:32 | index+1:32};
+    the tag changes on every update so a pop/push/pop by other threads (ABA) cannot
+    fool a stale compare_exchange.
+    Each slot also has a state (Idle / Leased / Checking). The health checker claims one
+    idle slot at a time with Idle → Checking and leaves it on the free-list; a caller
+    that pops a slot under check puts it back and takes the next one.
+*/
+class ConnectionPool;
+
+class ConnectionLease {
+    ConnectionPool* pool = nullptr;
+    uint32_t slot = 0;
+
+public:
+    ConnectionLease() {}
+    ConnectionLease(ConnectionPool* pool, uint32_t slot) : pool(pool), slot(slot) {}
+    ConnectionLease(ConnectionLease&& other) noexcept : pool(other.pool), slot(other.slot) {
+        other.pool = nullptr;
+    }
+    ConnectionLease(const ConnectionLease&) = delete;
+    ConnectionLease& operator=(const ConnectionLease&) = delete;
+    ConnectionLease& operator=(ConnectionLease&&) = delete;
+    inline ~ConnectionLease();
+
+    explicit operator bool() const { return pool != nullptr; }
+    inline DatabaseConnection* operator->() const;
+};
+
+struct PoolConfig {
+    string host = "localhost";
+    int port = 5432;
+    string user;
+    string password;
+    int poolSize = 4;
+    chrono::milliseconds timeout{30};
+    chrono::milliseconds healthCheckInterval{20};
+};
+
+class ConnectionPool {
+    PoolConfig config;
+    vector<unique_ptr<DatabaseConnection>> connections;
+    unique_ptr<atomic<uint32_t>[]> next;     // next[i] = index+1 of the node below i (0 = none)
+    enum SlotState : uint8_t { Idle, Leased, Checking };
+    unique_ptr<atomic<uint8_t>[]> state;
+    atomic<uint64_t> head{0};
+    atomic<bool> running{true};
+    atomic<long> reconnects{0};
+    thread healthChecker;
+
+    static uint64_t pack(uint64_t tag, uint32_t indexPlusOne) { return (tag << 32) | indexPlusOne; }
+
+    bool tryPop(uint32_t& slot) {
+        uint64_t h = head.load(memory_order_acquire);
+        while (true) {
+            uint32_t top = static_cast<uint32_t>(h);
+            if (top == 0) return false;
+            uint32_t below = next[top - 1].load(memory_order_relaxed);
+            if (head.compare_exchange_weak(h, pack((h >> 32) + 1, below),
+                                           memory_order_acquire, memory_order_acquire)) {
+                slot = top - 1;
+                return true;
+            }
+        }
+    }
+
+    void push(uint32_t slot) {
+        uint64_t h = head.load(memory_order_relaxed);
+        do {
+            next[slot].store(static_cast<uint32_t>(h), memory_order_relaxed);
+        } while (!head.compare_exchange_weak(h, pack((h >> 32) + 1, slot + 1),
+                                             memory_order_release, memory_order_relaxed));
+    }
+
+    bool claim(uint32_t slot, uint8_t to) {
+        uint8_t idle = Idle;
+        return state[slot].compare_exchange_strong(idle, to, memory_order_acq_rel);
+    }
+
+    // Pop a slot and mark it leased. Only one slot is ever under check, so if the top one
+    // is, the next one down is free to take.
+    bool tryLease(uint32_t& slot) {
+        if (!tryPop(slot)) return false;
+        if (claim(slot, Leased)) return true;
+        uint32_t busy = slot;
+        bool got = tryPop(slot);
+        if (got && !claim(slot, Leased)) { push(slot); got = false; }   // checker moved on to it
+        push(busy);
+        return got;
+    }
+
+    // One idle connection at a time: claim it, ping, reconnect if dead, release the claim.
+    void healthLoop() {
+        while (running.load()) {
+            this_thread::sleep_for(config.healthCheckInterval);
+            for (uint32_t slot = 0; slot < connections.size() && running.load(); slot++) {
+                if (!claim(slot, Checking)) continue;                   // leased: checked next round
+                if (!connections[slot]->ping()) {
+                    connections[slot]->reconnect(config.user, config.password);
+                    reconnects++;
+                }
+                state[slot].store(Idle, memory_order_release);
+            }
+        }
+    }
+
+public:
+    ConnectionPool(FakeDatabaseServer& server, PoolConfig cfg)
+        : config(move(cfg)), next(new atomic<uint32_t>[config.poolSize]), state(new atomic<uint8_t>[config.poolSize]) {
+        // Pre-warm: pay every handshake once, up front
+        for (int i = 0; i < config.poolSize; i++) {
+            auto conn = make_unique<DatabaseConnection>(server, config.host, config.port);
+            conn->authenticate(config.user, config.password);
+            connections.push_back(move(conn));
+            next[i].store(0);
+            state[i].store(Idle);
+            push(static_cast<uint32_t>(i));
+        }
+        healthChecker = thread([this] { healthLoop(); });
+    }
+
+    ~ConnectionPool() {
+        running = false;
+        healthChecker.join();
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Empty lease if no connection frees up within the configured timeout.
+    ConnectionLease acquire() {
+        uint32_t slot;
+        if (tryLease(slot)) return ConnectionLease(this, slot);   // fast path
+
+        auto deadline = Clock::now() + config.timeout;
+        for (int spins = 0; Clock::now() < deadline; spins++) {
+            if (tryLease(slot)) return ConnectionLease(this, slot);
+            if (spins < 64) this_thread::yield();
+            else this_thread::sleep_for(chrono::microseconds(20));
+        }
+        return ConnectionLease();
+    }
+
+    void release(uint32_t slot) {
+        state[slot].store(Idle, memory_order_release);
+        push(slot);
+    }
+    DatabaseConnection* get(uint32_t slot) { return connections[slot].get(); }
+    long reconnectCount() const { return reconnects.load(); }
+};
+
+ConnectionLease::~ConnectionLease() {
+    if (pool) pool->release(slot);
+}
+
+DatabaseConnection* ConnectionLease::operator->() const { return pool->get(slot); }
+
+/*
+    🔹 Step 4: The Factory — all the setup the client used to do by hand
+*/
+class DatabaseConnectionFactory {
+public:
+    static unique_ptr<ConnectionPool> createPool(FakeDatabaseServer& server, const PoolConfig& config) {
+        cout << "Creating pool of " << config.poolSize << " connections to "
+             << config.host << ":" << config.port << " (timeout " << config.timeout.count() << "ms)\n";
+        return make_unique<ConnectionPool>(server, config);
+    }
+};
+
+/*
+    🔹 Step 5: Benchmark — acquire latency, pooled vs connect-per-request
+*/
+struct Percentiles {
+    double p50, p99;
+};
+
+Percentiles percentiles(vector<double>& us) {
+    sort(us.begin(), us.end());
+    return {us[us.size() / 2], us[us.size() * 99 / 100]};
+}
+
+template <typename Work>
+vector<double> measureAcquire(int threads, int requestsPerThread, Work work) {
+    vector<vector<double>> perThread(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < requestsPerThread; i++) perThread[t].push_back(work(i));
+        });
+    }
+    for (auto& w : workers) w.join();
+    vector<double> all;
+    for (auto& v : perThread) all.insert(all.end(), v.begin(), v.end());
+    return all;
+}
+
+int main() {
+    FakeDatabaseServer server(chrono::microseconds(2000), chrono::microseconds(1000)); // 3ms handshake
+    PoolConfig config;
+    config.user = "admin";
+    config.password = "password";
+    config.poolSize = 8;
+    config.timeout = chrono::milliseconds(30);
+
+    unique_ptr<ConnectionPool> pool = DatabaseConnectionFactory::createPool(server, config);
+    cout << "Database ready to use (" << server.handshakeCount() << " handshakes at startup)\n";
+
+    {
+        ConnectionLease db = pool->acquire();
+        if (db) cout << "query(21) = " << db->query(21) << endl;
+    }
+
+    // Health checker: drop everything, the background thread reconnects idle connections
+    // one by one while requests keep getting leases from the rest of the pool
+    server.dropAllConnections();
+    double slowest = 0;
+    for (auto end = Clock::now() + chrono::milliseconds(100); Clock::now() < end;) {
+        auto start = Clock::now();
+        ConnectionLease db = pool->acquire();
+        slowest = max(slowest, chrono::duration<double, milli>(Clock::now() - start).count());
+    }
+    cout << "after a dropped-connection event: " << pool->reconnectCount()
+         << " reconnects, slowest acquire meanwhile " << slowest << " ms\n";
+
+    // Timeout: hold every connection, the next acquire must give up
+    {
+        vector<ConnectionLease> held;
+        while (held.size() < static_cast<size_t>(config.poolSize)) {
+            ConnectionLease l = pool->acquire();
+            if (l) held.push_back(move(l));
+        }
+        auto start = Clock::now();
+        ConnectionLease extra = pool->acquire();
+        double waited = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "pool exhausted → acquire " << (extra ? "succeeded?!" : "timed out")
+             << " after " << waited << " ms\n\n";
+    }
+
+    const int threads = 8, requests = 50;
+    vector<double> naive = measureAcquire(threads, requests, [&](int i) {
+        auto start = Clock::now();
+        DatabaseConnection conn(server, config.host, config.port);
+        conn.authenticate(config.user, config.password);
+        double us = chrono::duration<double, micro>(Clock::now() - start).count();
+        conn.query(i);
+        return us;
+    });
+    vector<double> pooled = measureAcquire(threads, requests * 20, [&](int i) {
+        auto start = Clock::now();
+        ConnectionLease conn = pool->acquire();
+        double us = chrono::duration<double, micro>(Clock::now() - start).count();
+        if (conn) conn->query(i);
+        return us;
+    });
+
+    Percentiles n = percentiles(naive), p = percentiles(pooled);
+    cout << "acquire latency with " << threads << " threads:\n";
+    cout << "  connect + auth per request: p50 " << n.p50 << " us, p99 " << n.p99 << " us\n";
+    cout << "  pooled lease:               p50 " << p.p50 << " us, p99 " << p.p99 << " us\n";
+}
+
+/*
+    ✅ Result
+        - Handshake cost is paid poolSize times at startup instead of once per request.
+        - A lease is a CAS on the free-list head; the p99 only rises when every connection
+          is busy and callers must wait (bounded by the timeout).
+        - Broken connections are repaired off the request path by the health checker, one
+          at a time, so a reconnect sweep never makes the pool look empty.
+*/
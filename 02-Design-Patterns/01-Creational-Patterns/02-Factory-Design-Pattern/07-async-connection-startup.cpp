@@ -0,0 +1,266 @@
+/*
+    🚀 Example for 2️⃣ (continued) — Asynchronous connect + authenticate
+
+    DatabaseConnection in 02-factory-design-pattern.cpp connects in its constructor and
+    authenticates synchronously. Filling a pool of N connections one after another costs
+        N × (DNS + TCP connect + server greeting + auth round-trip)
+    at startup, even though the N handshakes are completely independent.
+
+    🔹 Fix: connectAsync(host, port, creds) returns a future.
+        The factory starts all N pipelines at once (each one does DNS → connect → auth)
+        and only then waits for the results. Cold start ≈ one handshake, not N.
+
+    The examples are C++17, so this uses std::future / std::async instead of coroutines;
+    the structure (start everything, then await everything) is the same.
+
+    LoopbackDbServer is a tiny real TCP server on 127.0.0.1 that injects a delay before
+    its greeting and before answering AUTH, so the benchmark measures real socket I/O.
+
+    Build & run (Linux / macOS):
+        g++ -std=c++17 -O2 -pthread 07-async-connection-startup.cpp -o async && ./async
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Small line-based socket helpers
+static bool sendLine(int fd, const string& line) {
+    string msg = line + "\n";
+    return send(fd, msg.data(), msg.size(), 0) == static_cast<ssize_t>(msg.size());
+}
+
+static bool readLine(int fd, string& out) {
+    out.clear();
+    char c;
+    while (true) {
+        ssize_t n = recv(fd, &c, 1, 0);
+        if (n <= 0) return false;
+        if (c == '\n') return true;
+        out += c;
+    }
+}
+
+/*
+    🔹 Step 1: Loopback stand-in server with injected latency
+*/
+class LoopbackDbServer {
+    int listenFd = -1;
+    int port = 0;
+    chrono::milliseconds greetingDelay;
+    chrono::milliseconds authDelay;
+    thread acceptor;
+    mutex workersMutex;
+    vector<thread> workers;
+
+    void serve(int fd) {
+        this_thread::sleep_for(greetingDelay);            // simulated TCP/TLS setup
+        sendLine(fd, "HELLO");
+        string line;
+        while (readLine(fd, line)) {
+            if (line.rfind("AUTH ", 0) == 0) {
+                this_thread::sleep_for(authDelay);        // simulated credential check
+                size_t space = line.find(' ', 5);
+                bool valid = space != string::npos && space > 5 && space + 1 < line.size();
+                sendLine(fd, valid ? "OK" : "DENIED");
+            } else if (line == "PING") {
+                sendLine(fd, "PONG");
+            }
+        }
+        close(fd);
+    }
+
+public:
+    LoopbackDbServer(chrono::milliseconds greetingDelay, chrono::milliseconds authDelay)
+        : greetingDelay(greetingDelay), authDelay(authDelay) {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;                                // let the OS pick a port
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0)
+            throw runtime_error("server: bind/listen failed");
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+
+        acceptor = thread([this] {
+            while (true) {
+                int fd = accept(listenFd, nullptr, nullptr);
+                if (fd < 0) return;                       // listening socket was shut down
+                lock_guard<mutex> lock(workersMutex);
+                workers.emplace_back([this, fd] { serve(fd); });
+            }
+        });
+    }
+
+    // All clients must have disconnected before the server is destroyed.
+    ~LoopbackDbServer() {
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptor.join();
+        for (auto& w : workers) w.join();
+    }
+
+    int getPort() const { return port; }
+};
+
+/*
+    🔹 Step 2: The product — synchronous API kept as before
+*/
+struct Credentials {
+    string user;
+    string password;
+};
+
+class DatabaseConnection {
+    int fd = -1;
+
+public:
+    DatabaseConnection(const string& host, int port) {
+        // DNS
+        addrinfo hints{}, *result = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(host.c_str(), to_string(port).c_str(), &hints, &result) != 0)
+            throw runtime_error("DNS lookup failed for " + host);
+
+        // TCP connect
+        fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        int rc = connect(fd, result->ai_addr, result->ai_addrlen);
+        freeaddrinfo(result);
+        if (rc != 0) {
+            close(fd);
+            throw runtime_error("connect failed to " + host + ":" + to_string(port));
+        }
+
+        // Server greeting
+        string greeting;
+        if (!readLine(fd, greeting) || greeting != "HELLO") {
+            close(fd);
+            throw runtime_error("bad greeting from server");
+        }
+    }
+
+    ~DatabaseConnection() {
+        if (fd >= 0) close(fd);
+    }
+
+    DatabaseConnection(const DatabaseConnection&) = delete;
+    DatabaseConnection& operator=(const DatabaseConnection&) = delete;
+
+    void authenticate(const string& user, const string& password) {
+        string reply;
+        if (!sendLine(fd, "AUTH " + user + " " + password) || !readLine(fd, reply) || reply != "OK")
+            throw runtime_error("authentication failed for " + user);
+    }
+
+    bool ping() {
+        string reply;
+        return sendLine(fd, "PING") && readLine(fd, reply) && reply == "PONG";
+    }
+};
+
+/*
+    🔹 Step 3: Async pipeline + Factory
+*/
+future<unique_ptr<DatabaseConnection>> connectAsync(string host, int port, Credentials creds) {
+    return async(launch::async, [host = move(host), port, creds = move(creds)] {
+        auto conn = make_unique<DatabaseConnection>(host, port);  // DNS + connect + greeting
+        conn->authenticate(creds.user, creds.password);            // auth round-trip
+        return conn;
+    });
+}
+
+class DatabaseConnectionFactory {
+public:
+    // Old behaviour: one handshake after another
+    static vector<unique_ptr<DatabaseConnection>> createPoolSequential(const string& host, int port,
+                                                                       const Credentials& creds, int size) {
+        vector<unique_ptr<DatabaseConnection>> pool;
+        for (int i = 0; i < size; i++) {
+            auto conn = make_unique<DatabaseConnection>(host, port);
+            conn->authenticate(creds.user, creds.password);
+            pool.push_back(move(conn));
+        }
+        return pool;
+    }
+
+    // New behaviour: start all handshakes, then wait for all of them
+    static vector<unique_ptr<DatabaseConnection>> createPoolAsync(const string& host, int port,
+                                                                  const Credentials& creds, int size) {
+        vector<future<unique_ptr<DatabaseConnection>>> pending;
+        for (int i = 0; i < size; i++) pending.push_back(connectAsync(host, port, creds));
+
+        vector<unique_ptr<DatabaseConnection>> pool;
+        for (auto& f : pending) pool.push_back(f.get());   // rethrows the first failure
+        return pool;
+    }
+};
+
+/*
+    🔹 Step 4: Startup-time benchmark
+*/
+template <typename Build>
+double timeStartup(Build build, size_t expected) {
+    auto start = Clock::now();
+    auto pool = build();
+    double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+    size_t healthy = 0;
+    for (auto& c : pool) healthy += c->ping();
+    if (healthy != expected) cout << "  !! only " << healthy << " healthy connections\n";
+    return ms;
+}
+
+int main() {
+    Credentials creds{"admin", "password"};
+    LoopbackDbServer server(chrono::milliseconds(5), chrono::milliseconds(5));   // ~10ms per handshake
+    int port = server.getPort();
+    cout << "Loopback DB listening on 127.0.0.1:" << port << "\n";
+
+    {
+        auto conn = connectAsync("localhost", port, creds).get();
+        cout << "single async connection ping: " << (conn->ping() ? "PONG" : "failed") << "\n\n";
+    }
+
+    for (int size : {1, 4, 16, 32}) {
+        double seq = timeStartup([&] {
+            return DatabaseConnectionFactory::createPoolSequential("localhost", port, creds, size);
+        }, size);
+        double par = timeStartup([&] {
+            return DatabaseConnectionFactory::createPoolAsync("localhost", port, creds, size);
+        }, size);
+        cout << "pool=" << size << "\tsequential: " << seq << " ms\tasync: " << par << " ms\n";
+    }
+
+    try {
+        DatabaseConnectionFactory::createPoolAsync("localhost", port, {"admin", ""}, 2);
+    } catch (const exception& e) {
+        cout << "\nbad credentials surface through the future: " << e.what() << endl;
+    }
+}
+
+/*
+    ✅ Result
+        - Sequential startup grows linearly with the pool size (N × handshake).
+        - Async startup stays close to a single handshake, because all N wait on the
+          network at the same time.
+        - Errors from any pipeline are rethrown by future::get(), so startup still fails loudly.
+*/
@@ -0,0 +1,277 @@
+/*
+    ⚙️ Abstract Factory without virtual calls — Static (compile-time) families
+
+    In 01-abstrac-factory-design-pattern.cpp every operation goes through virtual calls:
+        factory->createPayment()   (virtual + new)
+        payment->pay(amount)       (virtual)
+        refund->refund(amount)     (virtual)
+        delete payment / refund
+    But the gateway is chosen once from config at startup and never changes.
+    Paying for dynamic dispatch and heap allocation on every transaction buys nothing.
+
+    🔹 Idea
+        - A Family is a plain struct that names its products:
+              struct StripeFamily { using Payment = StripePayment; using Refund = StripeRefund; };
+        - StaticGatewayFactory<Family> creates products by value → no new, no vtable,
+          the compiler can inline pay()/refund() all the way into the caller.
+        - The business logic is a template on the family (checkout<Family>), chosen ONCE
+          at startup: dispatchGateway(config, callable).
+        - AnyGateway is a thin type-erased adapter (two function pointers) for code that
+          really needs to switch gateways at runtime.
+
+    The examples are C++17, so the "concept" is a static_assert over a detection trait.
+
+    Build & run:
+        g++ -std=c++17 -O2 02-static-gateway-factory.cpp -o static && ./static [stripe|razorpay]
+*/
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/*
+    🔹 Step 1: Concrete products — plain classes, no base, no virtual
+    pay()/refund() return the amount actually moved after gateway fees.
+*/
+
+// Stripe Family
+class StripePayment {
+public:
+    long pay(int amount) const { return amount - (amount * 29 / 1000 + 30); }   // 2.9% + 30
+};
+
+class StripeRefund {
+public:
+    long refund(int amount) const { return amount; }                             // full refund
+};
+
+// Razorpay Family
+class RazorpayPayment {
+public:
+    long pay(int amount) const { return amount - amount * 2 / 100; }             // 2%
+};
+
+class RazorpayRefund {
+public:
+    long refund(int amount) const { return amount - amount / 100; }              // 1% kept
+};
+
+struct StripeFamily {
+    static constexpr const char* name = "Stripe";
+    using Payment = StripePayment;
+    using Refund = StripeRefund;
+};
+
+struct RazorpayFamily {
+    static constexpr const char* name = "Razorpay";
+    using Payment = RazorpayPayment;
+    using Refund = RazorpayRefund;
+};
+
+/*
+    🔹 Step 2: Compile-time "concept": what a gateway family must provide
+*/
+template <typename F, typename = void>
+struct is_gateway_family : false_type {};
+
+template <typename F>
+struct is_gateway_family<F, void_t<
+    decltype(declval<const typename F::Payment&>().pay(0)),
+    decltype(declval<const typename F::Refund&>().refund(0)),
+    decltype(F::name)>> : true_type {};
+
+/*
+    🔹 Step 3: The static Abstract Factory
+*/
+template <typename Family>
+class StaticGatewayFactory {
+    static_assert(is_gateway_family<Family>::value,
+                  "Family must define name, Payment::pay(int) and Refund::refund(int)");
+
+public:
+    using Payment = typename Family::Payment;
+    using Refund = typename Family::Refund;
+
+    static const char* name() { return Family::name; }
+    Payment createPayment() const { return Payment{}; }   // by value, no heap
+    Refund createRefund() const { return Refund{}; }
+};
+
+// Business logic written once, compiled per family — fully inlinable
+template <typename Family>
+long checkout(const StaticGatewayFactory<Family>& factory, int amount, int refundAmount) {
+    auto payment = factory.createPayment();
+    auto refund = factory.createRefund();
+    return payment.pay(amount) - refund.refund(refundAmount);
+}
+
+// Startup: read config once, then everything below runs with a concrete family
+template <typename Fn>
+void dispatchGateway(const string& config, Fn&& fn) {
+    if (config == "stripe") fn(StaticGatewayFactory<StripeFamily>{});
+    else fn(StaticGatewayFactory<RazorpayFamily>{});
+}
+
+/*
+    🔹 Step 4: Thin type-erased adapter for runtime switching
+    One indirect call per operation, no allocation, no vtable in the products.
+*/
+class AnyGateway {
+    const char* gatewayName;
+    long (*payFn)(int);
+    long (*refundFn)(int);
+
+public:
+    template <typename Family>
+    AnyGateway(StaticGatewayFactory<Family>)
+        : gatewayName(Family::name),
+          payFn([](int a) { return StaticGatewayFactory<Family>{}.createPayment().pay(a); }),
+          refundFn([](int a) { return StaticGatewayFactory<Family>{}.createRefund().refund(a); }) {}
+
+    const char* name() const { return gatewayName; }
+    long pay(int amount) const { return payFn(amount); }
+    long refund(int amount) const { return refundFn(amount); }
+};
+
+/*
+    -------------------------------------------------------------------------------------
+    🔹 Baseline: the original virtual hierarchy (same fee math instead of cout)
+    -------------------------------------------------------------------------------------
+*/
+namespace dynamic_version {
+
+class Payment {
+public:
+    virtual long pay(int amount) = 0;
+    virtual ~Payment() = default;
+};
+
+class Refund {
+public:
+    virtual long refund(int amount) = 0;
+    virtual ~Refund() = default;
+};
+
+class StripePayment : public Payment {
+public:
+    long pay(int amount) override { return ::StripePayment().pay(amount); }
+};
+class StripeRefund : public Refund {
+public:
+    long refund(int amount) override { return ::StripeRefund().refund(amount); }
+};
+class RazorpayPayment : public Payment {
+public:
+    long pay(int amount) override { return ::RazorpayPayment().pay(amount); }
+};
+class RazorpayRefund : public Refund {
+public:
+    long refund(int amount) override { return ::RazorpayRefund().refund(amount); }
+};
+
+class PaymentGatewayFactory {
+public:
+    virtual Payment* createPayment() = 0;
+    virtual Refund* createRefund() = 0;
+    virtual ~PaymentGatewayFactory() = default;
+};
+
+class StripeFactory : public PaymentGatewayFactory {
+public:
+    Payment* createPayment() override { return new StripePayment(); }
+    Refund* createRefund() override { return new StripeRefund(); }
+};
+
+class RazorpayFactory : public PaymentGatewayFactory {
+public:
+    Payment* createPayment() override { return new RazorpayPayment(); }
+    Refund* createRefund() override { return new RazorpayRefund(); }
+};
+
+} // namespace dynamic_version
+
+template <typename Loop>
+void report(const string& label, int ops, Loop loop) {
+    auto start = chrono::steady_clock::now();
+    long checksum = loop();
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ops;
+    cout << "  " << label << ns << " ns per pay+refund   (checksum " << checksum << ")\n";
+}
+
+/*
+    Client Code
+*/
+int main(int argc, char** argv) {
+    string config = argc > 1 ? argv[1] : "razorpay";   // decided by config/env
+
+    dispatchGateway(config, [](auto factory) {
+        auto payment = factory.createPayment();
+        auto refund = factory.createRefund();
+        cout << factory.name() << ": Paid 1000, settled " << payment.pay(1000) << "\n";
+        cout << factory.name() << ": Refunded 500, returned " << refund.refund(500) << "\n";
+    });
+
+    AnyGateway runtime = StaticGatewayFactory<StripeFamily>{};
+    cout << "AnyGateway(" << runtime.name() << ") pay(1000) → " << runtime.pay(1000) << "\n";
+    runtime = StaticGatewayFactory<RazorpayFamily>{};
+    cout << "AnyGateway(" << runtime.name() << ") pay(1000) → " << runtime.pay(1000) << "\n\n";
+
+    const int ops = 20000000;
+    cout << "pay+refund loop, gateway = " << config << ":\n";
+
+    dynamic_version::PaymentGatewayFactory* factory = nullptr;
+    if (config == "stripe") factory = new dynamic_version::StripeFactory();
+    else factory = new dynamic_version::RazorpayFactory();
+
+    report("virtual, new products per txn:  ", ops, [&] {
+        long sum = 0;
+        for (int i = 0; i < ops; i++) {
+            dynamic_version::Payment* p = factory->createPayment();
+            dynamic_version::Refund* r = factory->createRefund();
+            sum += p->pay(i) - r->refund(i / 2);
+            delete p;
+            delete r;
+        }
+        return sum;
+    });
+
+    report("virtual, products reused:       ", ops, [&] {
+        dynamic_version::Payment* p = factory->createPayment();
+        dynamic_version::Refund* r = factory->createRefund();
+        long sum = 0;
+        for (int i = 0; i < ops; i++) sum += p->pay(i) - r->refund(i / 2);
+        delete p;
+        delete r;
+        return sum;
+    });
+    delete factory;
+
+    AnyGateway any = StaticGatewayFactory<RazorpayFamily>{};
+    if (config == "stripe") any = StaticGatewayFactory<StripeFamily>{};
+    report("AnyGateway (fn pointers):       ", ops, [&] {
+        long sum = 0;
+        for (int i = 0; i < ops; i++) sum += any.pay(i) - any.refund(i / 2);
+        return sum;
+    });
+
+    dispatchGateway(config, [&](auto staticFactory) {
+        report("StaticGatewayFactory (inlined): ", ops, [&] {
+            long sum = 0;
+            for (int i = 0; i < ops; i++) sum += checkout(staticFactory, i, i / 2);
+            return sum;
+        });
+    });
+}
+
+/*
+    ✅ Result
+        - The static version compiles down to the fee arithmetic itself; the loop can even
+          be vectorised, because nothing opaque is left in it.
+        - AnyGateway keeps runtime switching for the few places that need it, at the
+          cost of one indirect call and no allocation.
+        - Adding a family = one struct with name/Payment/Refund; missing pieces are a
+          compile error, not a runtime crash.
+*/
@@ -0,0 +1,547 @@
+/*
+    🛰️ Routing Gateway Factory — failover + hedged requests across families
+
+    The client in 01-abstrac-factory-design-pattern.cpp hardwires
+        PaymentGatewayFactory* factory = new RazorpayFactory();
+    so when Razorpay has a slow moment, every checkout waits for it.
+
+    🔹 RoutingGatewayFactory — still a PaymentGatewayFactory, so the client does not change
+        - Wraps several families (Stripe, Razorpay, ...) and creates one product of each
+        - Tracks per gateway: EWMA latency, EWMA error rate, recent p95 latency
+        - Sends each payment to the best-scoring gateway
+        - Failover: gateway returned an error → try the next one immediately
+        - Hedging: no answer after that gateway's p95 → send a duplicate to the next one,
+          first success wins
+        - Every request carries an idempotency key. A real gateway only dedupes keys it has
+          seen itself, so a hedge that succeeds on two gateways is two charges. The router
+          keeps its own CommitTable: the first success for a key is committed, every later
+          success is voided through the family that made it → the customer is charged once
+        - Attempts run on a small fixed pool of workers owned by the router: a burst only
+          makes the queue longer, and shutdown joins every worker
+
+    FakeGateway simulates a remote API with a normal latency, an occasional long tail and
+    an error rate, so the tail-latency win can be measured locally.
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 04-routing-gateway-factory.cpp -o routing && ./routing
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct PaymentRequest {
+    string idempotencyKey;
+    int amount;
+};
+
+struct PaymentResult {
+    bool ok = false;
+    string gateway;
+};
+
+/*
+    🔹 Step 1: One gateway's own charge ledger — it dedupes only the keys IT has seen
+*/
+class ChargeLedger {
+    mutex m;
+    unordered_map<string, bool> charged;   // key → voided?
+    long voided = 0;
+
+public:
+    void charge(const string& key) {
+        lock_guard<mutex> lock(m);
+        charged.emplace(key, false);       // a repeated key replays the existing charge
+    }
+    void voidCharge(const string& key) {
+        lock_guard<mutex> lock(m);
+        auto it = charged.find(key);
+        if (it != charged.end() && !it->second) { it->second = true; voided++; }
+    }
+    long charges() { lock_guard<mutex> lock(m); return static_cast<long>(charged.size()); }
+    long voids() { lock_guard<mutex> lock(m); return voided; }
+};
+
+/*
+    🔹 Step 2: Fake remote gateway with tail latency and errors
+*/
+class FakeGateway {
+    string name;
+    chrono::microseconds base, tail;
+    double tailProbability, errorRate;
+    ChargeLedger ledger;
+
+public:
+    FakeGateway(string name, chrono::microseconds base, chrono::microseconds tail,
+                double tailProbability, double errorRate)
+        : name(move(name)), base(base), tail(tail), tailProbability(tailProbability),
+          errorRate(errorRate) {}
+
+    PaymentResult charge(const PaymentRequest& req) {
+        thread_local mt19937 rng(random_device{}());
+        uniform_real_distribution<double> coin(0, 1);
+        auto jitter = chrono::microseconds(static_cast<long>(base.count() * coin(rng) * 0.5));
+        this_thread::sleep_for(coin(rng) < tailProbability ? tail : base + jitter);
+        if (coin(rng) < errorRate) return {false, name};
+        ledger.charge(req.idempotencyKey);
+        return {true, name};
+    }
+
+    void voidCharge(const PaymentRequest& req) { ledger.voidCharge(req.idempotencyKey); }
+
+    const string& getName() const { return name; }
+    long charges() { return ledger.charges(); }
+    long voids() { return ledger.voids(); }
+    long netCharges() { return ledger.charges() - ledger.voids(); }
+};
+
+/*
+    🔹 Step 3: Abstract Products / Factory (pay now takes a request with an idempotency key,
+              and a charge made by this family can be voided through it)
+*/
+class Payment {
+public:
+    virtual PaymentResult pay(const PaymentRequest& req) = 0;
+    virtual void voidCharge(const PaymentRequest& req) = 0;
+    virtual ~Payment() = default;
+};
+
+class Refund {
+public:
+    virtual void refund(int amount) = 0;
+    virtual ~Refund() = default;
+};
+
+class PaymentGatewayFactory {
+public:
+    virtual Payment* createPayment() = 0;
+    virtual Refund* createRefund() = 0;
+    virtual ~PaymentGatewayFactory() = default;
+};
+
+// Stripe Family
+class StripePayment : public Payment {
+    FakeGateway& api;
+public:
+    StripePayment(FakeGateway& api) : api(api) {}
+    PaymentResult pay(const PaymentRequest& req) override { return api.charge(req); }
+    void voidCharge(const PaymentRequest& req) override { api.voidCharge(req); }
+};
+
+class StripeRefund : public Refund {
+public:
+    void refund(int amount) override {
+        cout << "Stripe: Refunded " << amount << " successfully.\n";
+    }
+};
+
+class StripeFactory : public PaymentGatewayFactory {
+    FakeGateway& api;
+public:
+    StripeFactory(FakeGateway& api) : api(api) {}
+    Payment* createPayment() override { return new StripePayment(api); }
+    Refund* createRefund() override { return new StripeRefund(); }
+};
+
+// Razorpay Family
+class RazorpayPayment : public Payment {
+    FakeGateway& api;
+public:
+    RazorpayPayment(FakeGateway& api) : api(api) {}
+    PaymentResult pay(const PaymentRequest& req) override { return api.charge(req); }
+    void voidCharge(const PaymentRequest& req) override { api.voidCharge(req); }
+};
+
+class RazorpayRefund : public Refund {
+public:
+    void refund(int amount) override {
+        cout << "Razorpay: Refunded " << amount << " successfully.\n";
+    }
+};
+
+class RazorpayFactory : public PaymentGatewayFactory {
+    FakeGateway& api;
+public:
+    RazorpayFactory(FakeGateway& api) : api(api) {}
+    Payment* createPayment() override { return new RazorpayPayment(api); }
+    Refund* createRefund() override { return new RazorpayRefund(); }
+};
+
+/*
+    🔹 Step 4: Per-gateway health statistics
+*/
+class GatewayStats {
+    mutable mutex m;
+    double latencyEwmaUs = 0;
+    double errorEwma = 0;
+    bool seeded = false;
+    vector<double> recent;            // ring of recent latencies (us)
+    size_t next = 0, samples = 0;
+    double p95Us = 0;
+
+    static constexpr double Alpha = 0.05;
+    static constexpr size_t Window = 512;
+
+public:
+    GatewayStats() : recent(Window, 0) {}
+
+    void record(double latencyUs, bool error) {
+        lock_guard<mutex> lock(m);
+        if (!seeded) { latencyEwmaUs = latencyUs; seeded = true; }
+        latencyEwmaUs += Alpha * (latencyUs - latencyEwmaUs);
+        errorEwma += Alpha * ((error ? 1.0 : 0.0) - errorEwma);
+        recent[next] = latencyUs;
+        next = (next + 1) % Window;
+        if (++samples % 32 == 0) {                                 // refresh p95 now and then
+            size_t n = min(samples, Window);
+            vector<double> copy(recent.begin(), recent.begin() + n);
+            nth_element(copy.begin(), copy.begin() + n * 95 / 100, copy.end());
+            p95Us = copy[n * 95 / 100];
+        }
+    }
+
+    // Lower is better: slow or failing gateways get pushed down the list
+    double score() const {
+        lock_guard<mutex> lock(m);
+        return latencyEwmaUs * (1.0 + 20.0 * errorEwma);
+    }
+
+    double p95() const {
+        lock_guard<mutex> lock(m);
+        return p95Us;
+    }
+};
+
+/*
+    🔹 Step 5: The router's commit table — the first success for a key wins, across gateways
+*/
+class CommitTable {
+    mutex m;
+    unordered_map<string, string> committed;   // key → gateway that holds the charge
+
+public:
+    // Returns the gateway that owns the key's charge: `gateway` if it is the first success
+    string commit(const string& key, const string& gateway) {
+        lock_guard<mutex> lock(m);
+        return committed.emplace(key, gateway).first->second;
+    }
+
+    // Gateway holding the key's charge, or "" if none
+    string owner(const string& key) {
+        lock_guard<mutex> lock(m);
+        auto it = committed.find(key);
+        return it == committed.end() ? string() : it->second;
+    }
+};
+
+/*
+    🔹 Step 6: The routing factory
+*/
+struct RoutingConfig {
+    bool hedging = true;
+    chrono::microseconds minHedgeDelay{500};
+    chrono::microseconds initialHedgeDelay{10000};   // before we have a p95
+    int workers = 32;                                // threads that run gateway calls
+};
+
+class RoutingGatewayFactory : public PaymentGatewayFactory {
+    struct Route {
+        string name;
+        PaymentGatewayFactory* family;
+        unique_ptr<Payment> payment;      // one product per family, reused for all calls
+        GatewayStats stats;
+    };
+
+    // Shared by the caller and the in-flight attempts of one payment
+    struct CallState {
+        mutex m;
+        condition_variable cv;
+        int outstanding = 0;
+        bool done = false;
+        PaymentResult winner;
+    };
+
+    struct Attempt {
+        Route* route;
+        PaymentRequest req;
+        shared_ptr<CallState> state;
+    };
+
+    vector<unique_ptr<Route>> routes;
+    RoutingConfig config;
+    CommitTable commits;
+    atomic<long> hedges{0}, failovers{0}, voided{0};
+
+    // Fixed worker pool: launch() queues an attempt, a worker runs it
+    mutex queueMutex;
+    condition_variable queueReady;
+    deque<Attempt> queue;
+    bool stopping = false;
+    vector<thread> workers;
+
+    vector<Route*> ranked() {
+        if (routes.empty()) throw logic_error("RoutingGatewayFactory has no routes registered");
+        vector<Route*> order;
+        for (auto& r : routes) order.push_back(r.get());
+        stable_sort(order.begin(), order.end(), [](Route* a, Route* b) { return a->stats.score() < b->stats.score(); });
+        return order;
+    }
+
+    chrono::microseconds hedgeDelay(Route* r) const {
+        double p95 = r->stats.p95();
+        if (p95 <= 0) return config.initialHedgeDelay;
+        return max(config.minHedgeDelay, chrono::microseconds(static_cast<long>(p95)));
+    }
+
+    void launch(Route* route, const PaymentRequest& req, shared_ptr<CallState> state) {
+        state->outstanding++;   // caller holds state->m
+        {
+            lock_guard<mutex> lock(queueMutex);
+            queue.push_back({route, req, move(state)});
+        }
+        queueReady.notify_one();
+    }
+
+    void run(Attempt& a) {
+        auto start = Clock::now();
+        PaymentResult r = a.route->payment->pay(a.req);
+        a.route->stats.record(chrono::duration<double, micro>(Clock::now() - start).count(), !r.ok);
+        if (r.ok) {
+            // Another gateway already holds this key's charge → undo ours, report the owner
+            r.gateway = commits.commit(a.req.idempotencyKey, a.route->name);
+            if (r.gateway != a.route->name) {
+                a.route->payment->voidCharge(a.req);
+                voided++;
+            }
+        }
+        {
+            lock_guard<mutex> lock(a.state->m);
+            a.state->outstanding--;
+            if (r.ok && !a.state->done) {
+                a.state->winner = r;
+                a.state->done = true;
+            }
+        }
+        a.state->cv.notify_all();
+    }
+
+    // Runs queued attempts until shutdown, and drains the queue before exiting
+    void workerLoop() {
+        while (true) {
+            unique_lock<mutex> lock(queueMutex);
+            queueReady.wait(lock, [&] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            Attempt a = move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            run(a);
+        }
+    }
+
+    PaymentResult route(const PaymentRequest& req) {
+        vector<Route*> order = ranked();
+        auto state = make_shared<CallState>();
+        unique_lock<mutex> lock(state->m);
+        size_t nextRoute = 0;
+        launch(order[nextRoute++], req, state);
+
+        while (true) {
+            auto deadline = Clock::now() + hedgeDelay(order[nextRoute - 1]);
+            bool canHedge = config.hedging && nextRoute < order.size();
+            auto finished = [&] { return state->done || state->outstanding == 0; };
+
+            if (canHedge) state->cv.wait_until(lock, deadline, finished);
+            else state->cv.wait(lock, finished);
+
+            if (state->done) return state->winner;
+            if (nextRoute >= order.size()) {
+                if (state->outstanding == 0) return PaymentResult{};   // every gateway failed
+                continue;
+            }
+            if (state->outstanding == 0) failovers++;   // error → fail over
+            else hedges++;                              // slow → hedge
+            launch(order[nextRoute++], req, state);
+        }
+    }
+
+    class RoutedPayment : public Payment {
+        RoutingGatewayFactory& router;
+    public:
+        RoutedPayment(RoutingGatewayFactory& router) : router(router) {}
+        PaymentResult pay(const PaymentRequest& req) override { return router.route(req); }
+        void voidCharge(const PaymentRequest& req) override { router.voidCommitted(req); }
+    };
+
+    void voidCommitted(const PaymentRequest& req) {
+        string owner = commits.owner(req.idempotencyKey);
+        for (auto& r : routes)
+            if (r->name == owner) r->payment->voidCharge(req);
+    }
+
+public:
+    RoutingGatewayFactory(vector<pair<string, PaymentGatewayFactory*>> families, RoutingConfig config)
+        : config(config) {
+        for (auto& f : families) {
+            auto r = make_unique<Route>();
+            r->name = f.first;
+            r->family = f.second;
+            r->payment.reset(f.second->createPayment());
+            routes.push_back(move(r));
+        }
+        if (config.workers < 1) throw invalid_argument("RoutingConfig::workers must be at least 1");
+        for (int i = 0; i < config.workers; i++) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    // Hedged losers may still be queued or running; finish them before the products go away
+    ~RoutingGatewayFactory() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    Payment* createPayment() override { return new RoutedPayment(*this); }
+    Refund* createRefund() override { return ranked().front()->family->createRefund(); }
+
+    long hedgeCount() const { return hedges.load(); }
+    long failoverCount() const { return failovers.load(); }
+    long voidCount() const { return voided.load(); }
+};
+
+/*
+    🔹 Step 7: Benchmark
+*/
+struct RunReport {
+    vector<double> latencyMs;
+    long failed = 0;
+};
+
+RunReport runClients(PaymentGatewayFactory& factory, const string& prefix, int threads, int perThread) {
+    vector<RunReport> parts(threads);
+    vector<thread> clients;
+    for (int t = 0; t < threads; t++) {
+        clients.emplace_back([&, t] {
+            unique_ptr<Payment> payment(factory.createPayment());
+            for (int i = 0; i < perThread; i++) {
+                PaymentRequest req{prefix + "-" + to_string(t) + "-" + to_string(i), 1000 + i};
+                auto start = Clock::now();
+                PaymentResult r = payment->pay(req);
+                parts[t].latencyMs.push_back(chrono::duration<double, milli>(Clock::now() - start).count());
+                if (!r.ok) parts[t].failed++;
+            }
+        });
+    }
+    for (auto& c : clients) c.join();
+    RunReport all;
+    for (auto& p : parts) {
+        all.latencyMs.insert(all.latencyMs.end(), p.latencyMs.begin(), p.latencyMs.end());
+        all.failed += p.failed;
+    }
+    sort(all.latencyMs.begin(), all.latencyMs.end());
+    return all;
+}
+
+// Net charges are summed over every gateway's own ledger, as the customer's bank would see them
+void printReport(const string& label, const RunReport& r, const vector<FakeGateway*>& gateways) {
+    auto pct = [&](double p) { return r.latencyMs[static_cast<size_t>(p * (r.latencyMs.size() - 1))]; };
+    long charges = 0, voids = 0;
+    for (FakeGateway* g : gateways) { charges += g->charges(); voids += g->voids(); }
+    cout << label << "\n    p50 " << pct(0.50) << " ms, p95 " << pct(0.95) << " ms, p99 " << pct(0.99)
+         << " ms, p99.9 " << pct(0.999) << " ms | failed " << r.failed
+         << ", charged " << charges << ", voided " << voids << ", net " << charges - voids
+         << " for " << static_cast<long>(r.latencyMs.size()) - r.failed << " successful payments\n";
+}
+
+// One payment, hedged onto a second gateway, where BOTH calls succeed
+void doubleChargeCheck() {
+    FakeGateway slow("stripe", chrono::microseconds(30000), chrono::microseconds(30000), 1.0, 0.0);
+    FakeGateway fast("razorpay", chrono::microseconds(1000), chrono::microseconds(1000), 1.0, 0.0);
+    StripeFactory stripe(slow);
+    RazorpayFactory razorpay(fast);
+    PaymentResult r;
+    {
+        RoutingGatewayFactory router({{"stripe", &stripe}, {"razorpay", &razorpay}}, RoutingConfig{});
+        unique_ptr<Payment> payment(router.createPayment());
+        r = payment->pay({"order-42", 500});
+    }   // the slow stripe attempt finishes (and is voided) before the router is gone
+    long net = slow.netCharges() + fast.netCharges();
+    cout << "hedged payment committed on " << r.gateway << " | stripe charged " << slow.charges()
+         << ", voided " << slow.voids() << " | razorpay charged " << fast.charges() << ", voided "
+         << fast.voids() << " | net charges " << net << (net == 1 ? " (ok)" : " (DOUBLE CHARGE)") << "\n";
+}
+
+int main() {
+    const int threads = 16, perThread = 150;
+
+    // Both gateways: ~2-3ms normally, a few % of calls take 40-60ms, Razorpay errors 1%
+    // Each gateway keeps its own ledger, like the real services
+    auto makeGateways = [] {
+        return make_pair(
+            make_unique<FakeGateway>("stripe", chrono::microseconds(2000), chrono::microseconds(40000), 0.03, 0.002),
+            make_unique<FakeGateway>("razorpay", chrono::microseconds(1800), chrono::microseconds(60000), 0.04, 0.01));
+    };
+
+    {
+        auto gw = makeGateways();
+        RazorpayFactory razorpay(*gw.second);
+        PaymentGatewayFactory* factory = &razorpay;   // hardwired, as in the original client
+        printReport("hardwired RazorpayFactory", runClients(*factory, "a", threads, perThread), {gw.second.get()});
+    }
+
+    doubleChargeCheck();
+
+    {
+        RoutingGatewayFactory empty({}, RoutingConfig{});
+        unique_ptr<Payment> payment(empty.createPayment());
+        try {
+            payment->pay({"x-0", 100});
+        } catch (const logic_error& e) {
+            cout << "router without routes: " << e.what() << "\n";
+        }
+    }
+
+    for (bool hedging : {false, true}) {
+        auto gw = makeGateways();
+        StripeFactory stripe(*gw.first);
+        RazorpayFactory razorpay(*gw.second);
+        RoutingConfig config;
+        config.hedging = hedging;
+        RunReport r;
+        long hedges, failovers, voids;
+        {
+            RoutingGatewayFactory router({{"stripe", &stripe}, {"razorpay", &razorpay}}, config);
+            r = runClients(router, hedging ? "c" : "b", threads, perThread);
+            hedges = router.hedgeCount();
+            failovers = router.failoverCount();
+            voids = router.voidCount();
+        }   // router joins its workers here, so the ledgers are final
+        printReport(hedging ? "RoutingGatewayFactory, failover + hedging" : "RoutingGatewayFactory, failover only",
+                    r, {gw.first.get(), gw.second.get()});
+        cout << "    hedges sent " << hedges << ", failovers " << failovers << ", late successes voided " << voids << "\n";
+    }
+}
+
+/*
+    ✅ Result
+        - Hardwired: p99 is the gateway's tail latency, and its errors reach the customer.
+        - Failover removes the errors; hedging cuts p99/p99.9 to roughly p95 + one normal
+          call, for a few % extra requests.
+        - "net" always equals the number of successful payments, even though each gateway
+          only dedupes its own keys: the router commits the first success per key and voids
+          the hedge that lost, through the gateway that charged it.
+*/
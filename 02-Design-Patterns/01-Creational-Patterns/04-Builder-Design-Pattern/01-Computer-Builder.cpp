@@ -1,4 +1,5 @@
 #include <iostream>
+#include <string>
 using namespace std;
 
 class Computer {
@@ -10,7 +11,7 @@ private:
 
 public:
     Computer(string cpu, string ram, string gpu, bool wifi)
-        : cpu(cpu), ram(ram), gpu(gpu), wifi(wifi) {}
+        : cpu(move(cpu)), ram(move(ram)), gpu(move(gpu)), wifi(wifi) {}
 
     void show() {
         cout << cpu << " " << ram << " " << gpu << " wifi:" << wifi << endl;
@@ -22,25 +23,43 @@ class ComputerBuilder {
         string cpu;
         string ram;
         string gpu;
+        bool wifi = false;
 
     public:
-        ComputerBuilder& setCPU(string c) {
-            cpu = c;
+        // Take by value and move: a temporary/literal is moved all the way in, an lvalue is copied once.
+        // Each setter has an && twin so a chain on a temporary builder stays an rvalue and build() can move.
+        ComputerBuilder& setCPU(string c) & {
+            cpu = move(c);
             return *this;
         }
+        ComputerBuilder&& setCPU(string c) && { return move(setCPU(move(c))); }
 
-        ComputerBuilder& setRAM(string r) {
-            ram = r;
+        ComputerBuilder& setRAM(string r) & {
+            ram = move(r);
             return *this;
         }
+        ComputerBuilder&& setRAM(string r) && { return move(setRAM(move(r))); }
 
-        ComputerBuilder& setGPU(string g) {
-            gpu = g;
+        ComputerBuilder& setGPU(string g) & {
+            gpu = move(g);
             return *this;
         }
+        ComputerBuilder&& setGPU(string g) && { return move(setGPU(move(g))); }
 
-        Computer build() {
-            return Computer(cpu, ram, gpu);
+        ComputerBuilder& setWifi(bool w) & {
+            wifi = w;
+            return *this;
+        }
+        ComputerBuilder&& setWifi(bool w) && { return move(setWifi(w)); }
+
+        // Temporary builder: hands the fields over to Computer (moved, not copied)
+        Computer build() && {
+            return Computer(move(cpu), move(ram), move(gpu), wifi);
+        }
+
+        // Named builder: copies, so it can build again (same as before)
+        Computer build() const& {
+            return Computer(cpu, ram, gpu, wifi);
         }
     };
 
@@ -50,9 +69,18 @@ int main() {
                 .setCPU("i9")
                 .setRAM("32GB")
                 .setGPU("RTX")
+                .setWifi(true)
                 .build();
 
     c.show();
+
+    // A named builder can build several identical computers
+    ComputerBuilder office;
+    office.setCPU("i5").setRAM("16GB").setGPU("Integrated");
+    Computer first = office.build();
+    Computer second = office.build();
+    first.show();
+    second.show();
 }
 
 /*
@@ -0,0 +1,271 @@
+/*
+    🧮 Allocation-Aware ComputerBuilder
+
+    The first version of 01-Computer-Builder.cpp copied every spec string twice:
+        setCPU(string c) { cpu = c; }              → copy #1 (parameter) + copy #2 (member)
+        build() { return Computer(cpu, ram, gpu); } → copy #3 (argument) + copy #4 (member)
+    Short specs like "i9" fit in std::string's small buffer (SSO, 15 chars in libstdc++),
+    but real catalog names do not: "Intel Core i9-13900K", "NVIDIA GeForce RTX 4090".
+    Then every copy is a heap allocation → several allocations per field per Computer.
+
+    We compare three builders over 10M builds, counting allocations with a global
+    operator new hook:
+        1. CopyingBuilder   → the original by-value + copy style (wifi fixed)
+        2. MovingBuilder    → by-value + move into the builder, build() moves out
+        3. InternedBuilder  → specs interned once into a SpecTable; Computer stores
+                              3 × uint32 ids + wifi (16 bytes, trivially copyable) and
+                              is built in place with emplace_back
+
+    Build & run:
+        g++ -std=c++17 -O2 04-Allocation-Aware-Builder.cpp -o builder && ./builder
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <deque>
+#include <stdexcept>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+using namespace std;
+
+/*
+    🔹 Allocation counter (every operator new in the program goes through here)
+*/
+static long long allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/*
+    1️⃣ Original style: by-value parameters copied into the builder, copied again by build()
+*/
+namespace copying {
+
+class Computer {
+    string cpu, ram, gpu;
+    bool wifi;
+public:
+    Computer(string cpu, string ram, string gpu, bool wifi)
+        : cpu(cpu), ram(ram), gpu(gpu), wifi(wifi) {}
+    size_t checksum() const { return cpu.size() + ram.size() + gpu.size() + wifi; }
+};
+
+class ComputerBuilder {
+    string cpu, ram, gpu;
+    bool wifi = false;
+public:
+    ComputerBuilder& setCPU(string c) { cpu = c; return *this; }
+    ComputerBuilder& setRAM(string r) { ram = r; return *this; }
+    ComputerBuilder& setGPU(string g) { gpu = g; return *this; }
+    ComputerBuilder& setWifi(bool w) { wifi = w; return *this; }
+    Computer build() { return Computer(cpu, ram, gpu, wifi); }
+};
+
+} // namespace copying
+
+/*
+    2️⃣ Move-aware: each value is copied at most once (when the caller passes an lvalue),
+       and build() on a temporary builder moves everything into Computer
+       (a named builder copies, so it can still build again)
+*/
+namespace moving {
+
+class Computer {
+    string cpu, ram, gpu;
+    bool wifi;
+public:
+    Computer(string cpu, string ram, string gpu, bool wifi)
+        : cpu(move(cpu)), ram(move(ram)), gpu(move(gpu)), wifi(wifi) {}
+    size_t checksum() const { return cpu.size() + ram.size() + gpu.size() + wifi; }
+};
+
+class ComputerBuilder {
+    string cpu, ram, gpu;
+    bool wifi = false;
+public:
+    ComputerBuilder& setCPU(string c) & { cpu = move(c); return *this; }
+    ComputerBuilder& setRAM(string r) & { ram = move(r); return *this; }
+    ComputerBuilder& setGPU(string g) & { gpu = move(g); return *this; }
+    ComputerBuilder& setWifi(bool w) & { wifi = w; return *this; }
+    // && twins keep a chain on a temporary an rvalue, so it ends in build() &&
+    ComputerBuilder&& setCPU(string c) && { return move(setCPU(move(c))); }
+    ComputerBuilder&& setRAM(string r) && { return move(setRAM(move(r))); }
+    ComputerBuilder&& setGPU(string g) && { return move(setGPU(move(g))); }
+    ComputerBuilder&& setWifi(bool w) && { return move(setWifi(w)); }
+    Computer build() && { return Computer(move(cpu), move(ram), move(gpu), wifi); }
+    Computer build() const& { return Computer(cpu, ram, gpu, wifi); }
+};
+
+} // namespace moving
+
+/*
+    3️⃣ Interned specs: each distinct spec string is stored once in a SpecTable.
+       Builder and Computer only carry 32-bit ids → no allocation per build at all.
+*/
+namespace interned {
+
+using SpecId = uint32_t;
+constexpr SpecId NoSpec = UINT32_MAX;         // "not set": never handed out by intern()
+
+// Single-threaded: intern() grows the table without a lock, so intern the catalog before
+// builders on other threads start reading names
+class SpecTable {
+    deque<string> specs;                      // deque never relocates its elements on push_back
+    unordered_map<string_view, SpecId> ids;   // views point into `specs`, which stay put
+    SpecTable() {}
+
+public:
+    static SpecTable& getInstance() {
+        static SpecTable instance;
+        return instance;
+    }
+
+    // Cold path: first sight of a spec (allocates once per distinct spec)
+    SpecId intern(string_view spec) {
+        auto it = ids.find(spec);
+        if (it != ids.end()) return it->second;
+        if (specs.size() == NoSpec) throw length_error("spec table full");
+        specs.emplace_back(spec);
+        SpecId id = static_cast<SpecId>(specs.size() - 1);
+        ids.emplace(specs.back(), id);
+        return id;
+    }
+
+    const string& name(SpecId id) const {
+        if (id >= specs.size()) throw out_of_range("spec id not in the table");
+        return specs[id];
+    }
+};
+
+class Computer {
+    SpecId cpu, ram, gpu;
+    bool wifi;
+public:
+    Computer(SpecId cpu, SpecId ram, SpecId gpu, bool wifi) : cpu(cpu), ram(ram), gpu(gpu), wifi(wifi) {}
+    size_t checksum() const {
+        const SpecTable& t = SpecTable::getInstance();
+        return t.name(cpu).size() + t.name(ram).size() + (gpu == NoSpec ? 0 : t.name(gpu).size()) + wifi;
+    }
+    void show() const {
+        const SpecTable& t = SpecTable::getInstance();
+        cout << t.name(cpu) << " " << t.name(ram) << " " << (gpu == NoSpec ? "no-gpu" : t.name(gpu)) << " wifi:" << wifi << endl;
+    }
+};
+
+class ComputerBuilder {
+    SpecId cpu = NoSpec, ram = NoSpec, gpu = NoSpec;   // GPU is optional
+    bool wifi = false;
+
+    void check() const {
+        if (cpu == NoSpec || ram == NoSpec) throw invalid_argument("CPU and RAM are mandatory");
+    }
+public:
+    // Hot path: the catalog already holds ids
+    ComputerBuilder& setCPU(SpecId c) { cpu = c; return *this; }
+    ComputerBuilder& setRAM(SpecId r) { ram = r; return *this; }
+    ComputerBuilder& setGPU(SpecId g) { gpu = g; return *this; }
+    // Convenience: text in, interned once
+    ComputerBuilder& setCPU(string_view c) { return setCPU(SpecTable::getInstance().intern(c)); }
+    ComputerBuilder& setRAM(string_view r) { return setRAM(SpecTable::getInstance().intern(r)); }
+    ComputerBuilder& setGPU(string_view g) { return setGPU(SpecTable::getInstance().intern(g)); }
+    ComputerBuilder& setWifi(bool w) { wifi = w; return *this; }
+
+    Computer build() const { check(); return Computer(cpu, ram, gpu, wifi); }
+    // Construct directly inside the inventory, no temporary
+    Computer& buildInto(vector<Computer>& inventory) const {
+        check();
+        return inventory.emplace_back(cpu, ram, gpu, wifi);
+    }
+};
+
+} // namespace interned
+
+/*
+    🔹 Benchmark
+*/
+const vector<string> cpus = {"Intel Core i9-13900K", "AMD Ryzen 9 7950X3D", "Apple M3 Max 16-core CPU"};
+const vector<string> rams = {"32GB DDR5-6000 CL30 Kit", "64GB DDR5-5600 ECC Registered"};
+const vector<string> gpus = {"NVIDIA GeForce RTX 4090 24GB", "AMD Radeon RX 7900 XTX 24GB"};
+
+template <typename Build>
+void measure(const string& label, long builds, Build build) {
+    long long before = allocationCount;
+    size_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < builds; i++) checksum += build(i);
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / builds;
+    double allocs = double(allocationCount - before) / builds;
+    cout << label << "\t" << allocs << " allocs/build\t" << ns << " ns/build\t(checksum " << checksum << ")\n";
+}
+
+int main() {
+    interned::Computer c = interned::ComputerBuilder()
+                               .setCPU("i9")
+                               .setRAM("32GB")
+                               .setGPU("RTX")
+                               .setWifi(true)
+                               .build();
+    c.show();
+    try {
+        interned::ComputerBuilder().setCPU("i9").build();
+    } catch (const invalid_argument& e) {
+        cout << "builder without RAM: " << e.what() << "\n";
+    }
+    cout << "sizeof(Computer): copying " << sizeof(copying::Computer)
+         << " B, interned " << sizeof(interned::Computer) << " B\n\n";
+
+    const long builds = 10000000;
+
+    measure("copying  ", builds, [](long i) {
+        return copying::ComputerBuilder()
+            .setCPU(cpus[i % 3]).setRAM(rams[i % 2]).setGPU(gpus[i % 2]).setWifi(i & 1)
+            .build().checksum();
+    });
+
+    measure("moving   ", builds, [](long i) {
+        return moving::ComputerBuilder()
+            .setCPU(cpus[i % 3]).setRAM(rams[i % 2]).setGPU(gpus[i % 2]).setWifi(i & 1)
+            .build().checksum();
+    });
+
+    // Intern the catalog once, then builds only move ids around
+    interned::SpecTable& table = interned::SpecTable::getInstance();
+    vector<interned::SpecId> cpuIds, ramIds, gpuIds;
+    for (auto& s : cpus) cpuIds.push_back(table.intern(s));
+    for (auto& s : rams) ramIds.push_back(table.intern(s));
+    for (auto& s : gpus) gpuIds.push_back(table.intern(s));
+
+    measure("interned ", builds, [&](long i) {
+        return interned::ComputerBuilder()
+            .setCPU(cpuIds[i % 3]).setRAM(ramIds[i % 2]).setGPU(gpuIds[i % 2]).setWifi(i & 1)
+            .build().checksum();
+    });
+
+    // Large inventory built in place: one allocation for the whole vector
+    vector<interned::Computer> inventory;
+    inventory.reserve(builds);
+    long long before = allocationCount;
+    interned::ComputerBuilder builder;
+    for (long i = 0; i < builds; i++)
+        builder.setCPU(cpuIds[i % 3]).setRAM(ramIds[i % 2]).setGPU(gpuIds[i % 2]).setWifi(i & 1).buildInto(inventory);
+    cout << "\ninventory of " << inventory.size() << " computers: " << allocationCount - before
+         << " allocations, " << inventory.size() * sizeof(interned::Computer) / 1048576 << " MB\n";
+}
+
+/*
+    ✅ Result
+        - copying: several heap allocations per field per build.
+        - moving: each long spec is copied once (from the catalog lvalue) and then only moved.
+        - interned: zero allocations per build; Computer shrinks from ~100 bytes of string
+          headers + heap text to 16 bytes, which also makes big inventories cache-friendly.
+*/
@@ -0,0 +1,269 @@
+/*
+    🔒 Typestate Builder — mandatory fields and call order checked by the compiler
+
+    01-Computer-Builder.cpp lists two ways to enforce mandatory fields / call order:
+        - validate inside build()   → a mistake is found at runtime (exception / bad object)
+        - use a Director            → correct only if everybody goes through the Director
+    Both are runtime checks.
+
+    🔹 Typestate idea
+        The builder's type records what has been set so far:
+            ComputerBuilder<NeedCPU>  --setCPU-->  ComputerBuilder<NeedRAM>  --setRAM-->  ComputerBuilder<Ready>
+        - setRAM() only exists on ComputerBuilder<NeedRAM>  → CPU must come first
+        - build() only exists on ComputerBuilder<Ready>     → forgetting CPU/RAM does not compile
+        - setGPU()/setWifi() are optional and allowed once the builder is Ready
+        Every method is constexpr, and Computer stores its text in fixed-size inline char
+        arrays (SpecText), so a fixed SKU built from literals is a compile-time constant —
+        and a Computer built at runtime owns its text, so it never dangles.
+
+    The "tests" for the compile errors are static_asserts at the bottom of the file: they
+    check that the wrong calls are not available (a detection trait), so the file only
+    compiles while the rules hold.
+
+    Build & run:
+        g++ -std=c++17 -O2 05-Typestate-Computer-Builder.cpp -o typestate && ./typestate
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <chrono>
+using namespace std;
+
+// Owned, fixed-capacity text: a literal type, so it works in constexpr code.
+// Too long → length_error (a compile error when it happens in a constant expression).
+class SpecText {
+public:
+    static constexpr size_t Capacity = 31;
+
+private:
+    char data[Capacity]{};
+    unsigned char len = 0;
+
+public:
+    constexpr SpecText() {}
+    constexpr SpecText(string_view s) {
+        if (s.size() > Capacity) throw length_error("spec longer than 31 characters");
+        for (size_t i = 0; i < s.size(); i++) data[i] = s[i];
+        len = static_cast<unsigned char>(s.size());
+    }
+
+    constexpr string_view view() const { return string_view(data, len); }
+    constexpr bool empty() const { return len == 0; }
+};
+
+// Product — literal type, so it can be a constexpr value
+class Computer {
+    SpecText cpu;
+    SpecText ram;
+    SpecText gpu;
+    bool wifi;
+
+public:
+    constexpr Computer(SpecText cpu, SpecText ram, SpecText gpu, bool wifi)
+        : cpu(cpu), ram(ram), gpu(gpu), wifi(wifi) {}
+
+    constexpr string_view getCPU() const { return cpu.view(); }
+    constexpr string_view getRAM() const { return ram.view(); }
+    constexpr string_view getGPU() const { return gpu.view(); }
+    constexpr bool hasWifi() const { return wifi; }
+
+    void show() const {
+        cout << cpu.view() << " " << ram.view() << " " << (gpu.empty() ? "no-gpu" : gpu.view()) << " wifi:" << wifi << endl;
+    }
+};
+
+/*
+    🔹 Step 1: Builder states
+*/
+struct NeedCPU {};
+struct NeedRAM {};
+struct Ready {};
+
+template <typename State = NeedCPU>
+class ComputerBuilder {
+    template <typename> friend class ComputerBuilder;
+
+    SpecText cpu;
+    SpecText ram;
+    SpecText gpu;
+    bool wifi = false;
+
+    template <typename From>
+    constexpr ComputerBuilder(const ComputerBuilder<From>& other)
+        : cpu(other.cpu), ram(other.ram), gpu(other.gpu), wifi(other.wifi) {}
+
+    template <typename S>
+    using Only = enable_if_t<is_same_v<State, S>, int>;
+
+public:
+    constexpr ComputerBuilder() {}
+
+    // Mandatory, first
+    template <typename S = NeedCPU, Only<S> = 0>
+    constexpr ComputerBuilder<NeedRAM> setCPU(string_view c) const {
+        ComputerBuilder<NeedRAM> next(*this);
+        next.cpu = c;
+        return next;
+    }
+
+    // Mandatory, after CPU
+    template <typename S = NeedRAM, Only<S> = 0>
+    constexpr ComputerBuilder<Ready> setRAM(string_view r) const {
+        ComputerBuilder<Ready> next(*this);
+        next.ram = r;
+        return next;
+    }
+
+    // Optional, once the mandatory fields are in
+    template <typename S = Ready, Only<S> = 0>
+    constexpr ComputerBuilder<Ready> setGPU(string_view g) const {
+        ComputerBuilder<Ready> next(*this);
+        next.gpu = g;
+        return next;
+    }
+
+    template <typename S = Ready, Only<S> = 0>
+    constexpr ComputerBuilder<Ready> setWifi(bool w) const {
+        ComputerBuilder<Ready> next(*this);
+        next.wifi = w;
+        return next;
+    }
+
+    // Only a Ready builder can build → no runtime validation needed. The text was
+    // length-checked by the setters (SpecText), so build() itself cannot fail.
+    template <typename S = Ready, Only<S> = 0>
+    constexpr Computer build() const noexcept {
+        return Computer(cpu, ram, gpu, wifi);
+    }
+};
+
+/*
+    🔹 Step 2: Fixed SKUs are compile-time constants
+*/
+constexpr Computer gamingSku = ComputerBuilder<>()
+                                   .setCPU("i9")
+                                   .setRAM("32GB")
+                                   .setGPU("RTX")
+                                   .setWifi(true)
+                                   .build();
+
+static_assert(gamingSku.getCPU() == "i9" && gamingSku.getRAM() == "32GB", "built at compile time");
+static_assert(gamingSku.hasWifi(), "built at compile time");
+
+/*
+    🔹 Step 3: "Compile-error tests" — these calls must NOT exist
+*/
+template <typename B, typename = void> struct canBuild : false_type {};
+template <typename B> struct canBuild<B, void_t<decltype(declval<B>().build())>> : true_type {};
+
+template <typename B, typename = void> struct canSetRAM : false_type {};
+template <typename B> struct canSetRAM<B, void_t<decltype(declval<B>().setRAM(""))>> : true_type {};
+
+template <typename B, typename = void> struct canSetCPU : false_type {};
+template <typename B> struct canSetCPU<B, void_t<decltype(declval<B>().setCPU(""))>> : true_type {};
+
+template <typename B, typename = void> struct canSetGPU : false_type {};
+template <typename B> struct canSetGPU<B, void_t<decltype(declval<B>().setGPU(""))>> : true_type {};
+
+static_assert(!canBuild<ComputerBuilder<NeedCPU>>::value, "build() without CPU and RAM must not compile");
+static_assert(!canBuild<ComputerBuilder<NeedRAM>>::value, "build() without RAM must not compile");
+static_assert(canBuild<ComputerBuilder<Ready>>::value, "build() with CPU and RAM must compile");
+static_assert(!canSetRAM<ComputerBuilder<NeedCPU>>::value, "setRAM() before setCPU() must not compile");
+static_assert(!canSetCPU<ComputerBuilder<Ready>>::value, "setCPU() twice must not compile");
+static_assert(!canSetGPU<ComputerBuilder<NeedRAM>>::value, "optional parts only after mandatory ones");
+static_assert(noexcept(declval<ComputerBuilder<Ready>>().build()), "build() on a Ready builder cannot throw");
+
+/*
+    🔹 Step 4: Runtime-validating builder (Approach 2 from 01-Computer-Builder.cpp)
+*/
+class ValidatingComputerBuilder {
+    SpecText cpu;
+    SpecText ram;
+    SpecText gpu;
+    bool wifi = false;
+
+public:
+    ValidatingComputerBuilder& setCPU(string_view c) { cpu = c; return *this; }
+    ValidatingComputerBuilder& setRAM(string_view r) {
+        if (cpu.empty()) throw logic_error("setCPU must be called before setRAM");
+        ram = r;
+        return *this;
+    }
+    ValidatingComputerBuilder& setGPU(string_view g) { gpu = g; return *this; }
+    ValidatingComputerBuilder& setWifi(bool w) { wifi = w; return *this; }
+
+    Computer build() const {
+        if (cpu.empty() || ram.empty()) throw invalid_argument("CPU and RAM are mandatory");
+        return Computer(cpu, ram, gpu, wifi);
+    }
+};
+
+/*
+    🔹 Step 5: Benchmark with runtime (non-literal) inputs
+*/
+const string_view cpus[] = {"i5", "i7", "i9", "Ryzen 7"};
+const string_view rams[] = {"16GB", "32GB", "64GB"};
+
+template <typename Build>
+void measure(const char* label, long builds, Build build) {
+    size_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < builds; i++) checksum += build(i);
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / builds;
+    cout << label << ns << " ns/build (checksum " << checksum << ")\n";
+}
+
+int main() {
+    gamingSku.show();
+
+    Computer office = ComputerBuilder<>().setCPU("i5").setRAM("16GB").build();
+    office.show();
+
+    // ComputerBuilder<>().setRAM("16GB").build();   // ❌ does not compile: no setRAM on NeedCPU
+    // ComputerBuilder<>().setCPU("i5").build();     // ❌ does not compile: no build on NeedRAM
+
+    // Runtime text: the Computer keeps its own copy, the temporaries can go away
+    Computer custom = ComputerBuilder<>().setCPU(string("Ryzen ") + to_string(9)).setRAM(string("64GB")).build();
+    custom.show();
+
+    // The one runtime failure left: text longer than SpecText holds (with a literal in a
+    // constexpr build this is a compile error instead)
+    try {
+        ComputerBuilder<>().setCPU(string(40, 'x'));
+    } catch (const length_error& e) {
+        cout << "over-long runtime spec: " << e.what() << "\n";
+    }
+
+    try {
+        ValidatingComputerBuilder().setCPU("i5").build();
+    } catch (const exception& e) {
+        cout << "runtime builder only notices at runtime: " << e.what() << "\n\n";
+    }
+
+    const long builds = 50000000;
+    measure("runtime-validating builder: ", builds, [](long i) {
+        Computer c = ValidatingComputerBuilder().setCPU(cpus[i & 3]).setRAM(rams[i % 3]).setWifi(i & 1).build();
+        return c.getCPU().size() + c.getRAM().size() + c.hasWifi();
+    });
+    measure("typestate builder:          ", builds, [](long i) {
+        Computer c = ComputerBuilder<>().setCPU(cpus[i & 3]).setRAM(rams[i % 3]).setWifi(i & 1).build();
+        return c.getCPU().size() + c.getRAM().size() + c.hasWifi();
+    });
+    measure("constexpr SKU:              ", builds, [](long i) {
+        constexpr Computer sku = ComputerBuilder<>().setCPU("i9").setRAM("32GB").build();
+        return sku.getCPU().size() + sku.getRAM().size() + (i & 1);
+    });
+}
+
+/*
+    ✅ Result
+        - Forgetting a mandatory field or calling setters out of order is a compile error.
+        - The typestate builder has no checks left to run, so it costs the same as (or less
+          than) the validating one, and build() is noexcept. The setters still throw
+          length_error for runtime text over 31 characters (a compile error in constexpr).
+        - Fixed SKUs are folded to constants: zero runtime cost.
+*/
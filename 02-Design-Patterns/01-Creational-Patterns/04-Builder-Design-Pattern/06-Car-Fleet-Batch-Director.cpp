@@ -0,0 +1,310 @@
+/*
+    🚙 Bulk Director — building whole fleets into a Structure-of-Arrays
+
+    Director::construct(CarBuilder&) in 02-Car-Director-Builder.cpp builds ONE Car with
+    three virtual calls, and getCar() returns a copy. A fleet simulation with millions
+    of cars then stores vector<Car>:
+        Car = 2 × std::string (engine, transmission) + 3 bools  → ~72 bytes per car
+    and a question like "how many cars have GPS and a sunroof?" has to walk all of it.
+
+    🔹 Director::constructBatch(builder, n, fleet)
+        - Runs the builder's steps ONCE, then appends n identical cars in bulk
+          (the concrete builders are deterministic, so every car of one order is the same)
+        - CarFleet stores columns instead of objects:
+              engine[]        → 1 byte per car (interned id: "V8" → 0, "V6" → 1, ...)
+              transmission[]  → 1 byte per car (interned id)
+              gps / sunroof / airbags → packed bitsets, 1 bit per car
+          → 2 bytes + 3 bits per car
+        - Feature queries become word-wise AND + popcount over the bitsets
+
+    Build & run:
+        g++ -std=c++17 -O2 06-Car-Fleet-Batch-Director.cpp -o fleet && ./fleet
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+
+// Product (unchanged)
+class Car {
+public:
+    string engine;
+    string transmission;
+    bool hasGPS = false;
+    bool hasSunroof = false;
+    bool hasAirbags = false;
+
+    void showCar() const {
+        cout << "Car with " << engine << " engine, " << transmission << " transmission";
+        if (hasGPS) cout << ", GPS";
+        if (hasSunroof) cout << ", Sunroof";
+        if (hasAirbags) cout << ", Airbags";
+        cout << endl;
+    }
+};
+
+// Builder Interface (unchanged)
+class CarBuilder {
+public:
+    virtual void buildEngine() = 0;
+    virtual void buildTransmission() = 0;
+    virtual void buildFeatures() = 0;
+    virtual Car getCar() = 0;
+    virtual ~CarBuilder() = default;
+};
+
+class SportsCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V8"; }
+    void buildTransmission() override { car.transmission = "Manual"; }
+    void buildFeatures() override {
+        car.hasSunroof = true;
+        car.hasAirbags = true;
+    }
+    Car getCar() override { return car; }
+};
+
+class LuxuryCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V6"; }
+    void buildTransmission() override { car.transmission = "Automatic"; }
+    void buildFeatures() override {
+        car.hasGPS = true;
+        car.hasAirbags = true;
+        car.hasSunroof = true;
+    }
+    Car getCar() override { return car; }
+};
+
+class EconomyCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V4"; }
+    void buildTransmission() override { car.transmission = "Manual"; }
+    void buildFeatures() override {
+        car.hasAirbags = true;
+    }
+    Car getCar() override { return car; }
+};
+
+/*
+    🔹 Step 1: Small intern table — string ↔ 1-byte id
+*/
+class InternTable {
+    vector<string> names;
+public:
+    static constexpr int Missing = -1;
+
+    // Read-only lookup: id, or Missing if the name was never interned
+    int find(const string& name) const {
+        for (size_t i = 0; i < names.size(); i++)
+            if (names[i] == name) return int(i);
+        return Missing;
+    }
+
+    uint8_t intern(const string& name) {
+        int id = find(name);
+        if (id != Missing) return static_cast<uint8_t>(id);
+        if (names.size() > UINT8_MAX) throw length_error("more than 256 distinct names");
+        names.push_back(name);
+        return static_cast<uint8_t>(names.size() - 1);
+    }
+    const string& name(uint8_t id) const { return names[id]; }
+};
+
+/*
+    🔹 Step 2: Packed bitset that can append runs of identical bits quickly
+*/
+class BitColumn {
+    vector<uint64_t> words;
+    size_t bits = 0;
+
+public:
+    void appendRun(bool value, size_t n) {
+        words.resize((bits + n + 63) / 64, 0);
+        if (!value) { bits += n; return; }
+        size_t pos = bits;
+        bits += n;
+        while (pos < bits && (pos & 63)) { words[pos >> 6] |= 1ull << (pos & 63); pos++; }   // head
+        for (; pos + 64 <= bits; pos += 64) words[pos >> 6] = ~0ull;                         // whole words
+        for (; pos < bits; pos++) words[pos >> 6] |= 1ull << (pos & 63);                     // tail
+    }
+
+    bool get(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    size_t size() const { return bits; }
+    const vector<uint64_t>& data() const { return words; }
+    size_t bytes() const { return words.capacity() * sizeof(uint64_t); }
+};
+
+enum Feature : unsigned { GPS = 1, Sunroof = 2, Airbags = 4 };
+
+/*
+    🔹 Step 3: The fleet (Structure of Arrays)
+*/
+class CarFleet {
+    InternTable engines, transmissions;
+    vector<uint8_t> engine, transmission;
+    BitColumn gps, sunroof, airbags;
+
+public:
+    void reserve(size_t n) {
+        engine.reserve(n);
+        transmission.reserve(n);
+    }
+
+    void append(const Car& spec, size_t n) {
+        engine.insert(engine.end(), n, engines.intern(spec.engine));
+        transmission.insert(transmission.end(), n, transmissions.intern(spec.transmission));
+        gps.appendRun(spec.hasGPS, n);
+        sunroof.appendRun(spec.hasSunroof, n);
+        airbags.appendRun(spec.hasAirbags, n);
+    }
+
+    size_t size() const { return engine.size(); }
+
+    // Count cars having ALL features in `mask`: AND the selected bitsets, popcount the result
+    size_t countWith(unsigned mask) const {
+        const auto& g = gps.data();
+        const auto& s = sunroof.data();
+        const auto& a = airbags.data();
+        size_t count = 0;
+        for (size_t w = 0; w < g.size(); w++) {
+            uint64_t bits = ~0ull;
+            if (mask & GPS) bits &= g[w];
+            if (mask & Sunroof) bits &= s[w];
+            if (mask & Airbags) bits &= a[w];
+            if (w == g.size() - 1 && size() % 64) bits &= (1ull << (size() % 64)) - 1;   // padding past size()
+            count += __builtin_popcountll(bits);
+        }
+        return count;
+    }
+
+    size_t countEngine(const string& name) const {
+        int id = engines.find(name);
+        if (id == InternTable::Missing) return 0;   // unknown engine: nothing to count, nothing added
+        size_t count = 0;
+        for (uint8_t e : engine) count += (e == id);
+        return count;
+    }
+
+    // Rebuild a single Car object when a caller really needs one
+    Car at(size_t i) const {
+        Car car;
+        car.engine = engines.name(engine[i]);
+        car.transmission = transmissions.name(transmission[i]);
+        car.hasGPS = gps.get(i);
+        car.hasSunroof = sunroof.get(i);
+        car.hasAirbags = airbags.get(i);
+        return car;
+    }
+
+    size_t bytes() const {
+        return engine.capacity() + transmission.capacity() + gps.bytes() + sunroof.bytes() + airbags.bytes();
+    }
+};
+
+/*
+    🔹 Step 4: Director with a batch method
+*/
+class Director {
+public:
+    Car construct(CarBuilder& builder) {
+        builder.buildEngine();
+        builder.buildTransmission();
+        builder.buildFeatures();
+        return builder.getCar();
+    }
+
+    // Three virtual calls per ORDER of n cars, not per car
+    void constructBatch(CarBuilder& builder, size_t n, CarFleet& fleet) {
+        Car spec = construct(builder);
+        fleet.append(spec, n);
+    }
+};
+
+/*
+    🔹 Step 5: Benchmark
+*/
+struct Order {
+    CarBuilder* builder;
+    size_t count;
+};
+
+double seconds(chrono::steady_clock::time_point since) {
+    return chrono::duration<double>(chrono::steady_clock::now() - since).count();
+}
+
+int main() {
+    Director director;
+    SportsCarBuilder sportsBuilder;
+    LuxuryCarBuilder luxuryBuilder;
+    EconomyCarBuilder economyBuilder;
+
+    // Orders of random size and type, 4M cars in total
+    const size_t totalCars = 4000000;
+    vector<Order> orders;
+    mt19937 rng(3);
+    CarBuilder* builders[] = {&sportsBuilder, &luxuryBuilder, &economyBuilder};
+    for (size_t placed = 0; placed < totalCars;) {
+        size_t n = min<size_t>(1 + rng() % 500, totalCars - placed);
+        orders.push_back({builders[rng() % 3], n});
+        placed += n;
+    }
+
+    // Array of objects: one construct() per car
+    auto start = chrono::steady_clock::now();
+    vector<Car> cars;
+    cars.reserve(totalCars);
+    for (const Order& o : orders)
+        for (size_t i = 0; i < o.count; i++) cars.push_back(director.construct(*o.builder));
+    double aosBuild = seconds(start);
+
+    // Structure of arrays: one constructBatch() per order
+    start = chrono::steady_clock::now();
+    CarFleet fleet;
+    fleet.reserve(totalCars);
+    for (const Order& o : orders) director.constructBatch(*o.builder, o.count, fleet);
+    double soaBuild = seconds(start);
+
+    fleet.at(0).showCar();
+    cout << "\n" << fleet.size() << " cars\n";
+    cout << "build:   vector<Car> " << aosBuild * 1e3 << " ms\tCarFleet " << soaBuild * 1e3 << " ms\n";
+    cout << "memory:  vector<Car> " << cars.capacity() * sizeof(Car) / 1048576.0 << " MB\tCarFleet "
+         << fleet.bytes() / 1048576.0 << " MB\n";
+
+    // Query: GPS + sunroof
+    const int repeats = 20;
+    start = chrono::steady_clock::now();
+    size_t aosCount = 0;
+    for (int r = 0; r < repeats; r++) {
+        aosCount = 0;
+        for (const Car& c : cars) aosCount += (c.hasGPS && c.hasSunroof);
+    }
+    double aosQuery = seconds(start) / repeats;
+
+    start = chrono::steady_clock::now();
+    size_t soaCount = 0;
+    for (int r = 0; r < repeats; r++) soaCount = fleet.countWith(GPS | Sunroof);
+    double soaQuery = seconds(start) / repeats;
+
+    cout << "query:   vector<Car> " << aosQuery * 1e3 << " ms\tCarFleet " << soaQuery * 1e3
+         << " ms\t(GPS+Sunroof: " << aosCount << " / " << soaCount << ")\n";
+    cout << "V8 cars: " << fleet.countEngine("V8") << ", W12 cars: " << fleet.countEngine("W12")
+         << ", cars with no required feature: " << fleet.countWith(0) << "\n";
+}
+
+/*
+    ✅ Result
+        - Memory drops from ~72 bytes to ~2.4 bytes per car.
+        - A feature query reads 3 bits per car instead of a whole Car, and processes 64 cars
+          per popcount → orders of magnitude faster.
+        - Building a fleet is a few bulk fills per order instead of 3 virtual calls + a Car
+          copy (two strings) per car.
+*/
@@ -0,0 +1,396 @@
+/*
+    🏭 Pipelined Director — many car orders across cores
+
+    The Director in 02-Car-Director-Builder.cpp runs
+        buildEngine() → buildTransmission() → buildFeatures()
+    for ONE builder at a time on ONE thread. If a step is slow because it waits on
+    something (e.g. reserving an engine from a parts service), every order waits in line.
+
+    🔹 PipelinedDirector
+        - Each builder step is a pipeline stage; a job is (car, next stage)
+        - Orders enter through a bounded intake queue → when the workers fall behind,
+          submit() builds a car itself instead of letting unfinished builders pile up
+        - Work stealing: every worker owns a deque. It refills it with a small batch from
+          the intake, runs its own jobs from the back, and when it runs dry it steals the
+          oldest job from the front of another worker's deque. Workers flow to wherever
+          the work is, e.g. to cars stuck behind a worker sleeping in the slow I/O stage.
+        - A finished stage only moves its car back onto the worker's own deque, so no
+          step ever waits for queue space → no deadlock.
+        - A worker with nothing to run or steal parks on a condition variable.
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 07-Pipelined-Director.cpp -o pipeline && ./pipeline
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Product (unchanged)
+class Car {
+public:
+    string engine;
+    string transmission;
+    bool hasGPS = false;
+    bool hasSunroof = false;
+    bool hasAirbags = false;
+
+    void showCar() const {
+        cout << "Car with " << engine << " engine, " << transmission << " transmission";
+        if (hasGPS) cout << ", GPS";
+        if (hasSunroof) cout << ", Sunroof";
+        if (hasAirbags) cout << ", Airbags";
+        cout << endl;
+    }
+};
+
+// Builder Interface (unchanged)
+class CarBuilder {
+public:
+    virtual void buildEngine() = 0;
+    virtual void buildTransmission() = 0;
+    virtual void buildFeatures() = 0;
+    virtual Car getCar() = 0;
+    virtual ~CarBuilder() = default;
+};
+
+class SportsCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V8"; }
+    void buildTransmission() override { car.transmission = "Manual"; }
+    void buildFeatures() override {
+        car.hasSunroof = true;
+        car.hasAirbags = true;
+    }
+    Car getCar() override { return car; }
+};
+
+class LuxuryCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V6"; }
+    void buildTransmission() override { car.transmission = "Automatic"; }
+    void buildFeatures() override {
+        car.hasGPS = true;
+        car.hasAirbags = true;
+        car.hasSunroof = true;
+    }
+    Car getCar() override { return car; }
+};
+
+class EconomyCarBuilder : public CarBuilder {
+    Car car;
+public:
+    void buildEngine() override { car.engine = "V4"; }
+    void buildTransmission() override { car.transmission = "Manual"; }
+    void buildFeatures() override {
+        car.hasAirbags = true;
+    }
+    Car getCar() override { return car; }
+};
+
+// Director (unchanged) — the sequential baseline
+class Director {
+public:
+    Car construct(CarBuilder& builder) {
+        builder.buildEngine();
+        builder.buildTransmission();
+        builder.buildFeatures();
+        return builder.getCar();
+    }
+};
+
+/*
+    🔹 Step 1: Simulated costs of each step
+*/
+struct StageCost {
+    chrono::microseconds io;    // waiting on an external service (sleep)
+    chrono::microseconds cpu;   // actual work (busy loop)
+};
+
+void simulate(const StageCost& cost) {
+    if (cost.io.count() > 0) this_thread::sleep_for(cost.io);
+    auto until = Clock::now() + cost.cpu;
+    while (Clock::now() < until) {}
+}
+
+// Decorator that adds the simulated costs to any builder, so the sequential Director
+// and the pipeline run exactly the same steps
+class CostlyBuilder : public CarBuilder {
+    unique_ptr<CarBuilder> inner;
+    StageCost engine, transmission, features;
+public:
+    CostlyBuilder(unique_ptr<CarBuilder> inner, StageCost e, StageCost t, StageCost f)
+        : inner(move(inner)), engine(e), transmission(t), features(f) {}
+    void buildEngine() override { simulate(engine); inner->buildEngine(); }
+    void buildTransmission() override { simulate(transmission); inner->buildTransmission(); }
+    void buildFeatures() override { simulate(features); inner->buildFeatures(); }
+    Car getCar() override { return inner->getCar(); }
+};
+
+/*
+    🔹 Step 2: Queues — the bounded intake and each worker's own deque
+*/
+template <typename T>
+class BoundedQueue {
+    mutex m;
+    deque<T> items;
+    size_t capacity;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    bool tryPush(T& item) {
+        lock_guard<mutex> lock(m);
+        if (items.size() >= capacity) return false;
+        items.push_back(move(item));
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        lock_guard<mutex> lock(m);
+        if (items.empty()) return false;
+        out = move(items.front());
+        items.pop_front();
+        return true;
+    }
+};
+
+// One per worker. The owner works at the back (LIFO: the car it just advanced is next,
+// so cars finish instead of piling up half-built), thieves take from the front (the
+// oldest job, usually a car that still has every stage ahead of it). The lock is only
+// contended while someone steals.
+template <typename T>
+class WorkDeque {
+    mutex m;
+    deque<T> items;
+
+public:
+    void push(T& item) {
+        lock_guard<mutex> lock(m);
+        items.push_back(move(item));
+    }
+
+    bool pop(T& out) {
+        lock_guard<mutex> lock(m);
+        if (items.empty()) return false;
+        out = move(items.back());
+        items.pop_back();
+        return true;
+    }
+
+    bool steal(T& out) {
+        lock_guard<mutex> lock(m);
+        if (items.empty()) return false;
+        out = move(items.front());
+        items.pop_front();
+        return true;
+    }
+};
+
+/*
+    🔹 Step 3: The pipelined director
+*/
+struct CarOrder {
+    int id;
+    unique_ptr<CarBuilder> builder;
+};
+
+class PipelinedDirector {
+    struct Stage {
+        string name;
+        function<void(CarBuilder&)> step;
+    };
+
+    // A car plus the stage it is waiting for
+    struct Job {
+        size_t stage = 0;
+        CarOrder order;
+    };
+
+    static constexpr size_t RefillBatch = 4;   // cars a worker takes from the intake at once
+
+    vector<Stage> stages;
+    BoundedQueue<CarOrder> intake;             // submit() → workers; full = back-pressure
+    vector<unique_ptr<WorkDeque<Job>>> local;  // one per worker
+    vector<thread> workers;
+    mutex outputMutex;
+    vector<Car> finished;
+    atomic<long> submitted{0}, completed{0};
+    atomic<bool> closed{false};
+
+    // Parking for idle workers: queued counts jobs in the intake and in every deque
+    mutex parkMutex;
+    condition_variable wake;
+    atomic<long> queued{0};
+
+    // Taking the lock orders the change before a parked worker's predicate check → no lost wakeup
+    void signal(bool all) {
+        { lock_guard<mutex> lock(parkMutex); }
+        if (all) wake.notify_all();
+        else wake.notify_one();
+    }
+
+    bool drained() const { return closed.load() && completed.load() == submitted.load(); }
+
+    // Run one stage of the job; returns true while the car has stages left
+    bool runStage(Job& job) {
+        stages[job.stage].step(*job.order.builder);
+        if (++job.stage < stages.size()) return true;
+        Car car = job.order.builder->getCar();
+        lock_guard<mutex> lock(outputMutex);
+        finished.push_back(move(car));
+        completed++;
+        if (drained()) signal(true);
+        return false;
+    }
+
+    // Own deque first, then a batch from the intake, then steal from the others
+    bool findJob(size_t self, Job& job) {
+        WorkDeque<Job>& mine = *local[self];
+        if (mine.pop(job)) {
+            queued--;
+            return true;
+        }
+        size_t taken = 0;
+        CarOrder order;
+        while (taken < RefillBatch && intake.tryPop(order)) {
+            Job fresh{0, move(order)};
+            mine.push(fresh);
+            taken++;
+        }
+        if (taken > 1) signal(false);                       // the rest of the batch is stealable
+        if (taken > 0 && mine.pop(job)) {
+            queued--;
+            return true;
+        }
+        for (size_t i = 1; i < local.size(); i++) {
+            if (local[(self + i) % local.size()]->steal(job)) {
+                queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        while (true) {
+            Job job;
+            if (findJob(self, job)) {
+                // The next stage goes back on our own deque; LIFO pops it straight away, so
+                // a car runs its stages back to back on one worker (warm cache) while the
+                // rest of the batch waits at the front for thieves
+                if (runStage(job)) {
+                    queued++;
+                    local[self]->push(job);
+                }
+                continue;
+            }
+            unique_lock<mutex> lock(parkMutex);
+            wake.wait(lock, [&] { return queued.load() > 0 || drained(); });
+            if (drained()) return;
+        }
+    }
+
+public:
+    PipelinedDirector(int threads, size_t queueCapacity = 64) : intake(queueCapacity) {
+        stages.push_back({"engine", [](CarBuilder& b) { b.buildEngine(); }});
+        stages.push_back({"transmission", [](CarBuilder& b) { b.buildTransmission(); }});
+        stages.push_back({"features", [](CarBuilder& b) { b.buildFeatures(); }});
+        for (int t = 0; t < threads; t++) local.push_back(make_unique<WorkDeque<Job>>());
+        for (int t = 0; t < threads; t++)
+            workers.emplace_back([this, t] { workerLoop(t); });
+    }
+
+    // While the intake is full, the caller builds the oldest queued car itself
+    void submit(CarOrder order) {
+        submitted++;
+        while (!intake.tryPush(order)) {
+            CarOrder oldest;
+            if (!intake.tryPop(oldest)) continue;           // a worker just took one → room now
+            queued--;
+            Job job{0, move(oldest)};
+            while (runStage(job)) {}
+        }
+        queued++;
+        signal(false);
+    }
+
+    // No more orders: wait for the pipeline to drain and return the cars
+    vector<Car> finish() {
+        closed = true;
+        signal(true);
+        for (auto& w : workers) w.join();
+        workers.clear();
+        return move(finished);
+    }
+
+    ~PipelinedDirector() {
+        if (!workers.empty()) finish();
+    }
+};
+
+/*
+    🔹 Step 4: Benchmark
+*/
+// Engine reservation waits ~300us on the parts service; the other steps are CPU work
+const StageCost engineCost{chrono::microseconds(300), chrono::microseconds(5)};
+const StageCost transmissionCost{chrono::microseconds(0), chrono::microseconds(10)};
+const StageCost featuresCost{chrono::microseconds(0), chrono::microseconds(10)};
+
+unique_ptr<CarBuilder> makeBuilder(int i) {
+    unique_ptr<CarBuilder> b;
+    switch (i % 3) {
+        case 0: b = make_unique<SportsCarBuilder>(); break;
+        case 1: b = make_unique<LuxuryCarBuilder>(); break;
+        default: b = make_unique<EconomyCarBuilder>(); break;
+    }
+    return make_unique<CostlyBuilder>(move(b), engineCost, transmissionCost, featuresCost);
+}
+
+int main() {
+    const int orders = 2000;
+
+    // Sequential baseline: Director one order at a time
+    auto start = Clock::now();
+    Director director;
+    for (int i = 0; i < orders; i++) {
+        auto b = makeBuilder(i);
+        director.construct(*b);
+    }
+    double baseline = orders / chrono::duration<double>(Clock::now() - start).count();
+    cout << "sequential Director:    " << baseline << " cars/s\n";
+
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        start = Clock::now();
+        PipelinedDirector pipeline(threads);
+        for (int i = 0; i < orders; i++) pipeline.submit({i, makeBuilder(i)});
+        vector<Car> cars = pipeline.finish();
+        double rate = cars.size() / chrono::duration<double>(Clock::now() - start).count();
+        cout << "pipeline, threads=" << threads << ":\t" << rate << " cars/s\t(x" << rate / baseline << ")\n";
+        if (threads == 1) { cout << "  first car: "; cars.front().showCar(); }
+    }
+    cout << "hardware threads: " << thread::hardware_concurrency()
+         << " (the submitting thread also helps run stages, so threads=1 already has two runners)\n";
+}
+
+/*
+    ✅ Result
+        - Waiting on the parts service overlaps across workers, so throughput grows with
+          threads even past the number of cores, until the CPU stages saturate the cores.
+        - The intake (64) and the refill batch (4 per worker) cap the cars in flight.
+        - Stealing keeps every worker busy without hand-tuning threads per stage; the
+          per-worker deques keep the common path off any shared lock, and idle workers
+          sleep instead of spinning.
+*/
@@ -0,0 +1,312 @@
+/*
+    🗄️ Prepared SQLQuery Builder — write once, placeholders, cached statements
+
+    SQLQuery::Builder in 03-SQL-Query-Builder.cpp:
+        where(string condition) → whereClause += " AND " + condition   (new string per clause)
+        str()                   → baseQuery + whereClause + orderBy + ";" (rebuilt on every call)
+    and the values are pasted into the SQL text ("age > 25"), so
+        - every query with different values is a different string (no statement reuse)
+        - the caller formats values into text (to_string, quoting, injection risk)
+
+    🔹 New Builder
+        - where(column, op, value): the SQL gets a "?" placeholder, the value goes into a
+          typed parameter vector → same query shape = same SQL text
+        - WHERE and ORDER BY are kept in separate buffers of the builder and joined in
+          build(), so clause order in the calls does not matter and orderBy() replaces
+        - reset(table) reuses a builder: its buffers keep their capacity (no reallocation
+          once they have grown)
+        - The joined text is looked up in a bounded per-thread LRU statement cache:
+          all queries with the same shape share ONE immutable PreparedStatement
+        - str() returns the cached text; nothing is rebuilt
+        - Identifiers (table, columns) are double-quoted and operators come from a
+          whitelist, so nothing the caller passes is pasted into the SQL unchecked
+
+    Build & run:
+        g++ -std=c++17 -O2 08-Prepared-SQL-Query-Builder.cpp -o prepared && ./prepared
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <memory>
+#include <unordered_map>
+#include <list>
+#include <stdexcept>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+using namespace std;
+
+/*
+    🔹 Allocation counter (every operator new in the program goes through here)
+*/
+static long long allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/*
+    🔹 Step 1: Typed parameters and the shared statement
+*/
+using SqlValue = variant<int64_t, double, string>;
+
+ostream& operator<<(ostream& os, const SqlValue& v) {
+    visit([&](const auto& x) {
+        if constexpr (is_same_v<decay_t<decltype(x)>, string>) os << "'" << x << "'";
+        else os << x;
+    }, v);
+    return os;
+}
+
+struct PreparedStatement {
+    string sql;   // immutable, shared by every query with this shape
+};
+
+class StatementCache {
+    static constexpr size_t Capacity = 1024;             // shapes kept per thread
+
+    struct Entry {
+        shared_ptr<const PreparedStatement> statement;
+        list<const string*>::iterator lru;
+    };
+    unordered_map<string, Entry> statements;
+    list<const string*> lru;                              // front = most recently used
+    StatementCache() {}
+
+public:
+    // One cache per thread → no locking on the hot path
+    static StatementCache& local() {
+        thread_local StatementCache cache;
+        return cache;
+    }
+
+    // Lookup by the builder's text; only a new shape allocates. When full, the least
+    // recently used shape is dropped (queries holding it keep their shared_ptr).
+    const shared_ptr<const PreparedStatement>& intern(const string& sql) {
+        auto it = statements.find(sql);
+        if (it != statements.end()) {
+            lru.splice(lru.begin(), lru, it->second.lru);
+            return it->second.statement;
+        }
+        if (statements.size() >= Capacity) {
+            auto victim = statements.find(*lru.back());   // the key lives in the node we erase,
+            lru.pop_back();                               // so erase by iterator, not by key
+            statements.erase(victim);
+        }
+        it = statements.emplace(sql, Entry{make_shared<const PreparedStatement>(PreparedStatement{sql}), {}}).first;
+        lru.push_front(&it->first);
+        it->second.lru = lru.begin();
+        return it->second.statement;
+    }
+
+    size_t size() const { return statements.size(); }
+};
+
+/*
+    🔹 Step 2: SQL text helpers — quoted identifiers, whitelisted operators
+*/
+string_view checkedIdentifier(string_view name) {
+    if (name.empty() || name.find('\0') != string_view::npos) throw invalid_argument("invalid SQL identifier");
+    return name;
+}
+
+// "name" with embedded quotes doubled: any checked name is safe inside the SQL text
+void appendIdentifier(string& out, string_view name) {
+    out.push_back('"');
+    for (char c : name) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+string_view checkedOperator(string_view op) {
+    for (string_view allowed : {"=", "!=", "<>", "<", "<=", ">", ">="})
+        if (op == allowed) return op;
+    throw invalid_argument("unsupported SQL operator: " + string(op));
+}
+
+/*
+    🔹 Step 3: The query and its builder
+*/
+class SQLQuery {
+    shared_ptr<const PreparedStatement> statement;
+    vector<SqlValue> params;
+
+public:
+    class Builder {
+        // Owned by this builder; clear() keeps their capacity for the next query
+        string base, whereClause, orderByClause, text;
+        vector<SqlValue> params;
+
+    public:
+        explicit Builder(string_view table) {
+            params.reserve(16);
+            reset(table);
+        }
+
+        // Start a new query with the same builder
+        Builder& reset(string_view table) {
+            checkedIdentifier(table);
+            base.clear();
+            base.append("SELECT * FROM ");
+            appendIdentifier(base, table);
+            whereClause.clear();
+            orderByClause.clear();
+            params.clear();
+            return *this;
+        }
+
+        Builder& where(string_view column, string_view op, SqlValue value) {
+            checkedIdentifier(column);                  // both throw before the builder changes
+            checkedOperator(op);
+            whereClause.append(whereClause.empty() ? " WHERE " : " AND ");
+            appendIdentifier(whereClause, column);
+            whereClause.append(" ").append(op).append(" ?");
+            params.push_back(move(value));
+            return *this;
+        }
+
+        // Replaces any earlier ORDER BY, like the original builder
+        Builder& orderBy(string_view column, bool descending = false) {
+            checkedIdentifier(column);
+            orderByClause.assign(" ORDER BY ");
+            appendIdentifier(orderByClause, column);
+            if (descending) orderByClause.append(" DESC");
+            return *this;
+        }
+
+        SQLQuery build() {
+            text.assign(base).append(whereClause).append(orderByClause).push_back(';');
+            SQLQuery query;
+            query.statement = StatementCache::local().intern(text);
+            query.params = params;                      // builder stays usable
+            return query;
+        }
+    };
+
+    const string& str() const { return statement->sql; }                 // cached, no rebuild
+    const vector<SqlValue>& parameters() const { return params; }
+    const PreparedStatement* prepared() const { return statement.get(); }
+};
+
+/*
+    🔹 Baseline: the original builder (string concatenation, values inlined)
+*/
+class LegacySQLQuery {
+    string baseQuery;
+    string whereClause;
+    string orderByClause;
+
+public:
+    class Builder;   // defined below: it holds a LegacySQLQuery, which must be complete first
+
+    string str() const {
+        return baseQuery + whereClause + orderByClause + ";";
+    }
+};
+
+class LegacySQLQuery::Builder {
+    LegacySQLQuery query;
+public:
+    Builder(string table) {
+        query.baseQuery = "SELECT * FROM " + table;
+    }
+
+    Builder& where(string condition) {
+        if (query.whereClause.empty())
+            query.whereClause = " WHERE " + condition;
+        else
+            query.whereClause += " AND " + condition;
+        return *this;
+    }
+
+    Builder& orderBy(string column) {
+        query.orderByClause = " ORDER BY " + column;
+        return *this;
+    }
+
+    LegacySQLQuery build() { return query; }
+};
+
+/*
+    🔹 Step 4: Benchmark — 10 predicates, different values every time
+*/
+template <typename Run>
+void measure(const string& label, long queries, Run run) {
+    long long before = allocationCount;
+    size_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < queries; i++) checksum += run(i);
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << label << queries / secs / 1e6 << " M queries/s\t"
+         << double(allocationCount - before) / queries << " allocs/query\t(checksum " << checksum << ")\n";
+}
+
+int main() {
+    SQLQuery query = SQLQuery::Builder("employees")
+                         .where("age", ">", int64_t(25))
+                         .where("department", "=", string("HR"))
+                         .orderBy("salary", true)
+                         .build();
+
+    cout << query.str() << endl;
+    cout << "params:";
+    for (const SqlValue& v : query.parameters()) cout << " " << v;
+    cout << "\n";
+
+    SQLQuery other = SQLQuery::Builder("employees")
+                         .orderBy("name")
+                         .where("age", ">", int64_t(40))
+                         .orderBy("salary", true)            // replaces ORDER BY name
+                         .where("department", "=", string("Sales"))
+                         .build();
+    cout << "same shape shares one statement: " << (query.prepared() == other.prepared() ? "yes" : "no") << "\n";
+
+    SQLQuery odd = SQLQuery::Builder("employees").where("nick\"name", "=", string("x")).build();
+    cout << "quoted identifier: " << odd.str() << "\n";
+    try {
+        SQLQuery::Builder("employees").where("age", "> 0; DROP TABLE employees; --", int64_t(1));
+    } catch (const invalid_argument& e) {
+        cout << "rejected: " << e.what() << "\n\n";
+    }
+
+    const long queries = 1000000;
+    static const char* columns[] = {"age", "salary", "dept_id", "level", "tenure",
+                                    "rating", "office_id", "team_id", "bonus", "manager_id"};
+
+    measure("legacy   (concat + inlined values):  ", queries, [](long i) {
+        LegacySQLQuery::Builder b("employees");
+        for (int c = 0; c < 10; c++) b.where(string(columns[c]) + " > " + to_string(i + c));
+        LegacySQLQuery q = b.orderBy("salary DESC").build();
+        return q.str().size() + q.str().size();   // str() called twice, rebuilt twice
+    });
+
+    SQLQuery::Builder b("employees");
+    measure("prepared (reused builder + cached):  ", queries, [&b](long i) {
+        b.reset("employees");
+        for (int c = 0; c < 10; c++) b.where(columns[c], ">", int64_t(i + c));
+        SQLQuery q = b.orderBy("salary", true).build();
+        return q.str().size() + q.str().size() + q.parameters().size();
+    });
+
+    cout << "statements cached: " << StatementCache::local().size() << "\n";
+}
+
+/*
+    ✅ Result
+        - Legacy: dozens of allocations per query (every "+" and every str() call) and a
+          unique SQL string per value combination.
+        - Prepared: the text is assembled in the reused builder's warm buffers and resolved
+          to a cached statement; the only allocation left is the query's parameter vector.
+        - Placeholders also mean values are never pasted into SQL → no injection through values;
+          quoted identifiers and the operator whitelist close the other two inputs.
+*/
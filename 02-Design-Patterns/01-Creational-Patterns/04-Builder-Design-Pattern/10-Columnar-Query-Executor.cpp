@@ -0,0 +1,588 @@
+/*
+    📊 Columnar Query Executor — running a built SQLQuery in-process
+
+    SQLQuery::Builder in 03-SQL-Query-Builder.cpp only produces a string. For tests and
+    edge caching we want to run the same built query against a local table, without a
+    database round-trip:
+        SQLQuery q = SQLQuery::Builder("employees")
+                         .where("age", ">", 30)
+                         .where("department", "=", "HR")
+                         .orderBy("salary", DESC).limit(10)
+                         .build();
+        ResultSet rows = ColumnarExecutor::execute(q, employees);
+
+    🔹 How it runs
+        - The table is stored by column: age[], salary[], level[], department[]
+          (text columns are dictionary-encoded to int codes, plus each code's lexical rank
+          so ORDER BY sorts by the text, not by insertion order)
+        - Each where() predicate is one filter kernel over one column, producing a bitmask
+          (1 bit per row). AVX2 compares 8 values per instruction and movemask turns the
+          result into 8 bits; a scalar kernel is the fallback on CPUs without AVX2
+        - AND-ed predicates combine by AND-ing the masks; words that are already 0 skip
+          the compare work of later predicates
+        - orderBy(...) + limit(k): partial top-k with a k-sized heap over the matches
+          instead of sorting every matching row
+
+    The baseline is a row store (vector<Employee>) that interprets the predicates row by row
+    and sorts all matches. Every query is checked to return the same rows on every path.
+
+    Build & run:
+        g++ -std=c++17 -O2 10-Columnar-Query-Executor.cpp -o columnar && ./columnar
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <variant>
+#include <queue>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#endif
+using namespace std;
+
+using SqlValue = variant<int64_t, double, string>;
+
+enum class Op { Lt, Le, Gt, Ge, Eq, Ne };
+
+inline bool matches(double x, Op op, double v) {
+    switch (op) {
+        case Op::Lt: return x < v;
+        case Op::Le: return x <= v;
+        case Op::Gt: return x > v;
+        case Op::Ge: return x >= v;
+        case Op::Eq: return x == v;
+        case Op::Ne: return x != v;
+    }
+    return false;
+}
+
+bool avx2Available() {
+#ifdef HAVE_AVX2_KERNEL
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+Op parseOp(string_view op) {
+    if (op == "<") return Op::Lt;
+    if (op == "<=") return Op::Le;
+    if (op == ">") return Op::Gt;
+    if (op == ">=") return Op::Ge;
+    if (op == "=") return Op::Eq;
+    if (op == "!=" || op == "<>") return Op::Ne;
+    throw invalid_argument("unsupported operator: " + string(op));
+}
+
+/*
+    🔹 Step 1: SQLQuery keeps its clauses in structured form (and can still print itself)
+*/
+struct Predicate {
+    string column;
+    string opText;
+    Op op;
+    SqlValue value;
+};
+
+class SQLQuery {
+    string table;
+    vector<Predicate> predicates;
+    string orderColumn;
+    bool descending = false;
+    size_t rowLimit = 0;          // 0 = no limit
+
+public:
+    class Builder;
+
+    const string& tableName() const { return table; }
+    const vector<Predicate>& where() const { return predicates; }
+    const string& orderBy() const { return orderColumn; }
+    bool isDescending() const { return descending; }
+    size_t limit() const { return rowLimit; }
+
+    string str() const {
+        string sql = "SELECT * FROM " + table;
+        for (size_t i = 0; i < predicates.size(); i++) {
+            const Predicate& p = predicates[i];
+            sql += (i == 0 ? " WHERE " : " AND ") + p.column + " " + p.opText + " ";
+            visit([&](const auto& v) {
+                if constexpr (is_same_v<decay_t<decltype(v)>, string>) sql += "'" + v + "'";
+                else sql += to_string(v);
+            }, p.value);
+        }
+        if (!orderColumn.empty()) sql += " ORDER BY " + orderColumn + (descending ? " DESC" : "");
+        if (rowLimit) sql += " LIMIT " + to_string(rowLimit);
+        return sql + ";";
+    }
+};
+
+// Defined after SQLQuery, because it holds a complete SQLQuery
+class SQLQuery::Builder {
+    SQLQuery query;
+public:
+    Builder(string table) { query.table = move(table); }
+
+    Builder& where(string column, string op, SqlValue value) {
+        Op parsed = parseOp(op);
+        query.predicates.push_back({move(column), move(op), parsed, move(value)});
+        return *this;
+    }
+    Builder& where(string column, string op, int value) { return where(move(column), move(op), SqlValue(int64_t(value))); }
+    Builder& where(string column, string op, const char* value) { return where(move(column), move(op), SqlValue(string(value))); }
+
+    Builder& orderBy(string column, bool descending = false) {
+        query.orderColumn = move(column);
+        query.descending = descending;
+        return *this;
+    }
+
+    Builder& limit(size_t n) {
+        query.rowLimit = n;
+        return *this;
+    }
+
+    SQLQuery build() { return move(query); }
+};
+
+/*
+    🔹 Step 2: Column store
+*/
+struct Column {
+    enum Type { Int, Float, Text } type;
+    vector<int32_t> ints;          // Int values, or dictionary codes for Text
+    vector<float> floats;
+    vector<string> dictionary;     // Text only: code → string
+    vector<int32_t> rank;          // Text only: code → position of the string in sorted order
+
+    void setDictionary(vector<string> words) {
+        dictionary = move(words);
+        vector<int32_t> byText(dictionary.size());
+        for (size_t i = 0; i < byText.size(); i++) byText[i] = static_cast<int32_t>(i);
+        sort(byText.begin(), byText.end(), [&](int32_t a, int32_t b) { return dictionary[a] < dictionary[b]; });
+        rank.resize(dictionary.size());
+        for (size_t r = 0; r < byText.size(); r++) rank[byText[r]] = static_cast<int32_t>(r);
+    }
+
+    int32_t codeOf(const string& text) const {
+        for (size_t i = 0; i < dictionary.size(); i++)
+            if (dictionary[i] == text) return static_cast<int32_t>(i);
+        return -1;                 // not in the table: matches nothing with "="
+    }
+    // Sort key: the value itself, or the lexical rank of the text
+    double key(size_t row) const {
+        if (type == Float) return floats[row];
+        return type == Text ? rank[ints[row]] : ints[row];
+    }
+};
+
+class ColumnarTable {
+    string tableName;
+    vector<string> names;
+    deque<Column> columns;         // deque: addColumn() references stay valid
+    size_t rows = 0;
+
+public:
+    explicit ColumnarTable(string name) : tableName(move(name)) {}
+
+    Column& addColumn(string name, Column::Type type) {
+        names.push_back(move(name));
+        columns.push_back(Column{type, {}, {}, {}, {}});
+        return columns.back();
+    }
+
+    const Column& column(const string& name) const {
+        for (size_t i = 0; i < names.size(); i++)
+            if (names[i] == name) return columns[i];
+        throw invalid_argument("unknown column: " + name);
+    }
+
+    void setRowCount(size_t n) { rows = n; }
+    size_t rowCount() const { return rows; }
+    const string& name() const { return tableName; }
+};
+
+/*
+    🔹 Step 3: Filter kernels (column → bitmask, AND-ed into the running mask)
+*/
+// Every op is one of three compares, optionally inverted: Ge = !Lt, Le = !Gt, Ne = !Eq
+// (the columns hold no NaNs, so the inversion is exact for floats too)
+enum Cmp { CmpGt, CmpLt, CmpEq };
+
+struct Kernel {
+    Cmp cmp;
+    bool invert;
+};
+
+Kernel kernelFor(Op op) {
+    switch (op) {
+        case Op::Gt: return {CmpGt, false};
+        case Op::Lt: return {CmpLt, false};
+        case Op::Eq: return {CmpEq, false};
+        case Op::Le: return {CmpGt, true};
+        case Op::Ge: return {CmpLt, true};
+        case Op::Ne: return {CmpEq, true};
+    }
+    return {CmpEq, false};
+}
+
+inline void store(uint64_t* mask, size_t w, uint64_t bits, bool first) {
+    mask[w] = first ? bits : (mask[w] & bits);
+}
+
+template <Cmp C, typename T>
+inline bool compare(T x, T v) {
+    if constexpr (C == CmpGt) return x > v;
+    else if constexpr (C == CmpLt) return x < v;
+    else return x == v;
+}
+
+template <Cmp C, typename T>
+void filterScalar(const T* col, size_t n, T v, bool invert, uint64_t* mask, bool first) {
+    uint64_t flip = invert ? ~0ull : 0;
+    for (size_t w = 0; w * 64 < n; w++) {
+        if (!first && mask[w] == 0) continue;
+        size_t base = w * 64, count = min<size_t>(64, n - base);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < count; j++) bits |= uint64_t(compare<C>(col[base + j], v)) << j;
+        bits ^= flip;
+        if (count < 64) bits &= (1ull << count) - 1;
+        store(mask, w, bits, first);
+    }
+}
+
+#ifdef HAVE_AVX2_KERNEL
+template <Cmp C>
+__attribute__((target("avx2"))) void filterAvx2(const int32_t* col, size_t n, int32_t v, bool invert,
+                                               uint64_t* mask, bool first) {
+    const __m256i value = _mm256_set1_epi32(v);
+    const uint64_t flip = invert ? ~0ull : 0;
+    size_t full = n / 64;
+    for (size_t w = 0; w < full; w++) {
+        if (!first && mask[w] == 0) continue;
+        const int32_t* p = col + w * 64;
+        uint64_t bits = 0;
+        for (int j = 0; j < 8; j++) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 8 * j));
+            __m256i m;
+            if constexpr (C == CmpGt) m = _mm256_cmpgt_epi32(x, value);
+            else if constexpr (C == CmpLt) m = _mm256_cmpgt_epi32(value, x);
+            else m = _mm256_cmpeq_epi32(x, value);
+            bits |= uint64_t(uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(m)))) << (8 * j);
+        }
+        store(mask, w, bits ^ flip, first);
+    }
+    // Tail: scalar kernel on the last partial word
+    if (n % 64) filterScalar<C>(col + full * 64, n % 64, v, invert, mask + full, first);
+}
+
+template <Cmp C>
+__attribute__((target("avx2"))) void filterAvx2(const float* col, size_t n, float v, bool invert,
+                                               uint64_t* mask, bool first) {
+    const __m256 value = _mm256_set1_ps(v);
+    const uint64_t flip = invert ? ~0ull : 0;
+    size_t full = n / 64;
+    for (size_t w = 0; w < full; w++) {
+        if (!first && mask[w] == 0) continue;
+        const float* p = col + w * 64;
+        uint64_t bits = 0;
+        for (int j = 0; j < 8; j++) {
+            __m256 x = _mm256_loadu_ps(p + 8 * j);
+            __m256 m;
+            if constexpr (C == CmpGt) m = _mm256_cmp_ps(x, value, _CMP_GT_OQ);
+            else if constexpr (C == CmpLt) m = _mm256_cmp_ps(x, value, _CMP_LT_OQ);
+            else m = _mm256_cmp_ps(x, value, _CMP_EQ_OQ);
+            bits |= uint64_t(uint32_t(_mm256_movemask_ps(m))) << (8 * j);
+        }
+        store(mask, w, bits ^ flip, first);
+    }
+    if (n % 64) filterScalar<C>(col + full * 64, n % 64, v, invert, mask + full, first);
+}
+#endif
+
+template <typename T>
+void filterColumn(const T* col, size_t n, T v, Kernel k, bool simd, uint64_t* mask, bool first) {
+#ifdef HAVE_AVX2_KERNEL
+    if (simd) {
+        switch (k.cmp) {
+            case CmpGt: filterAvx2<CmpGt>(col, n, v, k.invert, mask, first); break;
+            case CmpLt: filterAvx2<CmpLt>(col, n, v, k.invert, mask, first); break;
+            case CmpEq: filterAvx2<CmpEq>(col, n, v, k.invert, mask, first); break;
+        }
+        return;
+    }
+#else
+    (void)simd;
+#endif
+    switch (k.cmp) {
+        case CmpGt: filterScalar<CmpGt>(col, n, v, k.invert, mask, first); break;
+        case CmpLt: filterScalar<CmpLt>(col, n, v, k.invert, mask, first); break;
+        case CmpEq: filterScalar<CmpEq>(col, n, v, k.invert, mask, first); break;
+    }
+}
+
+/*
+    🔹 Step 4: The executor
+*/
+using ResultSet = vector<uint32_t>;   // matching row ids, in result order
+
+class ColumnarExecutor {
+
+    static void applyPredicate(const ColumnarTable& t, const Predicate& p, bool simd, uint64_t* mask, bool first) {
+        const Column& c = t.column(p.column);
+        Kernel k = kernelFor(p.op);
+        size_t n = t.rowCount();
+        if (c.type == Column::Text) {
+            const string* text = get_if<string>(&p.value);
+            if (!text || (p.op != Op::Eq && p.op != Op::Ne))
+                throw invalid_argument("text column " + p.column + " supports = and != with a text value");
+            filterColumn(c.ints.data(), n, c.codeOf(*text), k, simd, mask, first);
+            return;
+        }
+        double v = visit([&](const auto& x) -> double {
+            if constexpr (is_same_v<decay_t<decltype(x)>, string>)
+                throw invalid_argument("numeric column " + p.column + " compared with text");
+            else return double(x);
+        }, p.value);
+        bool exact;
+        if (c.type == Column::Float) {
+            // Float bound with the same meaning for float x: the nearest float at or below v
+            // for > and <=, at or above v for < and >= (x > 0.1 ⇔ x > 0.099999994f)
+            float bound = float(v);
+            if ((p.op == Op::Gt || p.op == Op::Le) && double(bound) > v) bound = nextafter(bound, -INFINITY);
+            if ((p.op == Op::Lt || p.op == Op::Ge) && double(bound) < v) bound = nextafter(bound, INFINITY);
+            exact = !isnan(v) && (double(bound) == v || (p.op != Op::Eq && p.op != Op::Ne));
+            if (exact) filterColumn(c.floats.data(), n, bound, k, simd, mask, first);
+        } else {
+            // Integer bound with the same meaning for int x: x > 30.5 ⇔ x > 30, x < 30.5 ⇔ x < 31
+            double bound = (p.op == Op::Gt || p.op == Op::Le) ? floor(v)
+                         : (p.op == Op::Lt || p.op == Op::Ge) ? ceil(v) : v;
+            exact = bound >= INT32_MIN && bound <= INT32_MAX && bound == floor(bound);
+            if (exact) filterColumn(c.ints.data(), n, int32_t(bound), k, simd, mask, first);
+        }
+        if (!exact && !matches(0, p.op, v)) {
+            // Out of range, = with a value the column cannot hold, or NaN: the same answer
+            // for every row, so it either keeps the mask as is or empties it
+            fill(mask, mask + (n + 63) / 64, 0);
+        }
+    }
+
+public:
+    static ResultSet execute(const SQLQuery& q, const ColumnarTable& t, bool allowSimd = true) {
+        if (q.tableName() != t.name()) throw invalid_argument("query is for table " + q.tableName());
+        bool simd = allowSimd && avx2Available();
+        size_t n = t.rowCount();
+        size_t words = (n + 63) / 64;
+
+        // 1. Filters: AND every predicate into one mask
+        vector<uint64_t> mask(words, ~0ull);
+        if (n % 64) mask.back() = (1ull << (n % 64)) - 1;
+        bool first = true;
+        for (const Predicate& p : q.where()) {
+            applyPredicate(t, p, simd, mask.data(), first);
+            first = false;
+        }
+
+        // 2. Without ORDER BY: matching rows in table order, up to the limit
+        size_t limit = q.limit() ? q.limit() : SIZE_MAX;
+        ResultSet out;
+        if (q.orderBy().empty()) {
+            for (size_t w = 0; w < words && out.size() < limit; w++)
+                for (uint64_t bits = mask[w]; bits && out.size() < limit; bits &= bits - 1)
+                    out.push_back(uint32_t(w * 64 + __builtin_ctzll(bits)));
+            return out;
+        }
+
+        // 3. ORDER BY: ties broken by row id so every path returns the same rows
+        const Column& key = t.column(q.orderBy());
+        bool desc = q.isDescending();
+        auto before = [&](uint32_t a, uint32_t b) {        // true if a comes first in the result
+            double ka = key.key(a), kb = key.key(b);
+            if (ka != kb) return desc ? ka > kb : ka < kb;
+            return a < b;
+        };
+
+        if (q.limit()) {
+            // Partial top-k: heap holds the best k so far, worst on top
+            priority_queue<uint32_t, vector<uint32_t>, decltype(before)> heap(before);
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+                    uint32_t row = uint32_t(w * 64 + __builtin_ctzll(bits));
+                    if (heap.size() < limit) heap.push(row);
+                    else if (before(row, heap.top())) { heap.pop(); heap.push(row); }
+                }
+            }
+            out.resize(heap.size());
+            for (size_t i = out.size(); i-- > 0;) { out[i] = heap.top(); heap.pop(); }
+            return out;
+        }
+
+        for (size_t w = 0; w < words; w++)
+            for (uint64_t bits = mask[w]; bits; bits &= bits - 1)
+                out.push_back(uint32_t(w * 64 + __builtin_ctzll(bits)));
+        sort(out.begin(), out.end(), before);
+        return out;
+    }
+};
+
+/*
+    🔹 Step 5: Baseline — row store, predicates interpreted per row, full sort
+*/
+struct Employee {
+    int32_t age;
+    float salary;
+    int32_t level;
+    int32_t department;            // code into the same dictionary
+};
+
+ResultSet executeRowStore(const SQLQuery& q, const vector<Employee>& rows, const Column& departments) {
+    auto field = [](const Employee& e, const string& column) -> double {
+        if (column == "age") return e.age;
+        if (column == "salary") return e.salary;
+        if (column == "level") return e.level;
+        return e.department;
+    };
+    ResultSet out;
+    for (size_t r = 0; r < rows.size(); r++) {
+        bool ok = true;
+        for (const Predicate& p : q.where()) {
+            double v = holds_alternative<string>(p.value) ? departments.codeOf(get<string>(p.value))
+                                                          : visit([](const auto& x) -> double {
+                                                                if constexpr (is_same_v<decay_t<decltype(x)>, string>) return 0;
+                                                                else return double(x);
+                                                            }, p.value);
+            if (!matches(field(rows[r], p.column), p.op, v)) { ok = false; break; }
+        }
+        if (ok) out.push_back(uint32_t(r));
+    }
+    if (!q.orderBy().empty()) {
+        bool desc = q.isDescending();
+        const string& col = q.orderBy();
+        sort(out.begin(), out.end(), [&](uint32_t a, uint32_t b) {
+            if (col == "department") {                  // text: compare the strings themselves
+                const string& ta = departments.dictionary[rows[a].department];
+                const string& tb = departments.dictionary[rows[b].department];
+                if (ta != tb) return desc ? ta > tb : ta < tb;
+                return a < b;
+            }
+            double ka = field(rows[a], col), kb = field(rows[b], col);
+            if (ka != kb) return desc ? ka > kb : ka < kb;
+            return a < b;
+        });
+    }
+    if (q.limit() && out.size() > q.limit()) out.resize(q.limit());
+    return out;
+}
+
+/*
+    🔹 Step 6: Benchmark over a synthetic employees table
+*/
+double millis(chrono::steady_clock::time_point since) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - since).count();
+}
+
+int main() {
+    const size_t rows = 10000000;
+
+    ColumnarTable employees("employees");
+    Column& age = employees.addColumn("age", Column::Int);
+    Column& salary = employees.addColumn("salary", Column::Float);
+    Column& level = employees.addColumn("level", Column::Int);
+    Column& department = employees.addColumn("department", Column::Text);
+    department.setDictionary({"HR", "Engineering", "Sales", "Ops", "Finance", "Legal", "Support", "Marketing"});
+    age.ints.resize(rows);
+    salary.floats.resize(rows);
+    level.ints.resize(rows);
+    department.ints.resize(rows);
+
+    vector<Employee> rowStore(rows);
+    mt19937 rng(17);
+    for (size_t r = 0; r < rows; r++) {
+        Employee e{int32_t(22 + rng() % 44), float(30000 + rng() % 170000), int32_t(1 + rng() % 10), int32_t(rng() % 8)};
+        rowStore[r] = e;
+        age.ints[r] = e.age;
+        salary.floats[r] = e.salary;
+        level.ints[r] = e.level;
+        department.ints[r] = e.department;
+    }
+    employees.setRowCount(rows);
+
+    vector<SQLQuery> queries;
+    queries.push_back(SQLQuery::Builder("employees")
+                          .where("age", ">", 30)
+                          .where("department", "=", "HR")
+                          .where("salary", ">=", SqlValue(150000.0))
+                          .orderBy("salary", true).limit(10)
+                          .build());
+    queries.push_back(SQLQuery::Builder("employees")
+                          .where("level", "=", 7)
+                          .where("age", "<", 40)
+                          .orderBy("age", true).limit(100)
+                          .build());
+    queries.push_back(SQLQuery::Builder("employees")
+                          .where("salary", ">", SqlValue(199900.0))
+                          .where("department", "!=", "Legal")
+                          .orderBy("salary")
+                          .build());
+    // Fractional and out-of-range bounds on int columns
+    queries.push_back(SQLQuery::Builder("employees")
+                          .where("age", ">", SqlValue(30.5))
+                          .where("age", "<=", SqlValue(int64_t(5000000000)))
+                          .where("level", "!=", SqlValue(7.5))
+                          .where("level", "<", SqlValue(2.5))
+                          .orderBy("age").limit(5)
+                          .build());
+    // Bounds a float cannot hold (150000.0000001 rounds to 150000.0f), ORDER BY a text column
+    queries.push_back(SQLQuery::Builder("employees")
+                          .where("salary", ">=", SqlValue(150000.0000001))
+                          .where("salary", "<", SqlValue(150001.0000001))
+                          .orderBy("department").limit(20)
+                          .build());
+
+    cout << rows / 1000000 << "M rows, AVX2 " << (avx2Available() ? "available" : "not available") << "\n\n";
+    for (const SQLQuery& q : queries) {
+        cout << q.str() << "\n";
+
+        auto start = chrono::steady_clock::now();
+        ResultSet expected = executeRowStore(q, rowStore, department);
+        double rowMs = millis(start);
+
+        start = chrono::steady_clock::now();
+        ResultSet scalar = ColumnarExecutor::execute(q, employees, false);
+        double scalarMs = millis(start);
+
+        start = chrono::steady_clock::now();
+        ResultSet simd = ColumnarExecutor::execute(q, employees, true);
+        double simdMs = millis(start);
+
+        cout << "  row store (interpreted):  " << rowMs << " ms\n"
+             << "  columnar scalar kernels:  " << scalarMs << " ms\n"
+             << "  columnar AVX2 kernels:    " << simdMs << " ms\t(" << rows / simdMs / 1000 << " M rows/s)\n"
+             << "  " << simd.size() << " rows, same result on every path: "
+             << (expected == scalar && expected == simd ? "yes" : "NO") << "\n";
+        if (!simd.empty()) {
+            uint32_t r = simd.front();
+            cout << "  first: age " << age.ints[r] << ", salary " << salary.floats[r] << ", level " << level.ints[r]
+                 << ", " << department.dictionary[department.ints[r]] << "\n";
+        }
+        cout << "\n";
+    }
+}
+
+/*
+    ✅ Result
+        - Each predicate is a tight pass over one column (4 bytes per row) instead of
+          walking whole rows and interpreting clauses per row.
+        - AVX2 compares 8 rows per instruction and emits mask bits directly; AND-ed
+          predicates skip words that are already empty.
+        - ORDER BY ... LIMIT k keeps a k-sized heap instead of sorting every match.
+*/
@@ -0,0 +1,270 @@
+/*
+    🐄 Copy-on-Write Prototype — clones that really share the heavy assets
+
+    02-Game-Character-Design.cpp clones with new Knight(*this), which copies every field.
+    The promise of the pattern is "don't reload heavy 3D models", but with fields held by
+    value a real Knight would copy its whole mesh and animation data on every clone:
+        class Knight { Model3D model; AnimationSet animations; string weapon; ... }
+        clone() → new Knight(*this) → copies megabytes per knight
+
+    🔹 Copy-on-write handles
+        - CowHandle<T> adopts a shared_ptr<const T>: nobody, not even the caller that made
+          the asset, can mutate what the clones share
+              read()  → the shared object, no copy
+              write() → first call copies the object into one this handle owns
+        - Knight keeps model, animations and weapon in CowHandles, and health/speed by value
+        - clone() copies three pointers (+ refcount increments) and two ints
+        - setWeapon() replaces only the weapon; tintArmor() copies only that knight's model
+
+    Build & run:
+        g++ -std=c++17 -O2 03-Copy-On-Write-Prototype.cpp -o cow && ./cow
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <unistd.h>
+using namespace std;
+
+/*
+    🔹 Step 1: Heavy assets
+*/
+struct Vertex {
+    float x, y, z;
+    float u, v;
+};
+
+struct Model3D {
+    string name;
+    vector<Vertex> vertices;
+    uint32_t tint = 0xffffff;
+    static inline long copies = 0;
+
+    Model3D(string n, size_t vertexCount) : name(move(n)), vertices(vertexCount) {
+        for (size_t i = 0; i < vertexCount; i++)
+            vertices[i] = {float(i), float(i) * 0.5f, float(i) * 0.25f, 0.f, 1.f};
+    }
+    Model3D(const Model3D& other) : name(other.name), vertices(other.vertices), tint(other.tint) { copies++; }
+};
+
+struct Keyframe {
+    float time;
+    float rotation[4];
+    float translation[3];
+};
+
+struct AnimationSet {
+    vector<Keyframe> walk, attack, idle;
+    static inline long copies = 0;
+
+    explicit AnimationSet(size_t frames) : walk(frames), attack(frames), idle(frames) {}
+    AnimationSet(const AnimationSet& other) : walk(other.walk), attack(other.attack), idle(other.idle) { copies++; }
+};
+
+struct Weapon {
+    string name;
+    int damage;
+};
+
+/*
+    🔹 Step 2: Copy-on-write handle
+*/
+template <typename T>
+class CowHandle {
+    shared_ptr<const T> ptr;
+    T* mine = nullptr;                      // set only while ptr is a copy write() made
+
+public:
+    explicit CowHandle(shared_ptr<const T> p) : ptr(move(p)) {}
+    CowHandle(const CowHandle& other) : ptr(other.ptr) {}           // a copy shares, it never owns
+    CowHandle& operator=(const CowHandle& other) { ptr = other.ptr; mine = nullptr; return *this; }
+
+    const T& read() const { return *ptr; }
+
+    // Exclusive, writable access: detach from the other sharers first.
+    // The use_count() shortcut (reuse our own copy while nobody has cloned it since) is
+    // only exact single-threaded: knights are cloned and mutated on one thread here. With
+    // clones made on other threads, detach whenever write() is called instead.
+    T& write() {
+        if (!mine || ptr.use_count() > 1) {
+            auto copy = make_shared<T>(*ptr);
+            mine = copy.get();
+            ptr = move(copy);
+        }
+        return *mine;
+    }
+
+    void reset(shared_ptr<const T> p) { ptr = move(p); mine = nullptr; }
+    bool sharesWith(const CowHandle& other) const { return ptr == other.ptr; }
+    long owners() const { return ptr.use_count(); }
+};
+
+/*
+    🔹 Step 3: Prototype + Knight
+*/
+class Prototype {
+public:
+    virtual Prototype* clone() = 0;
+    virtual void showDetails() = 0;
+    virtual ~Prototype() {}
+};
+
+class Knight : public Prototype {
+    CowHandle<Model3D> model;
+    CowHandle<AnimationSet> animations;
+    CowHandle<Weapon> weapon;
+    int health;
+    int speed;
+
+public:
+    Knight(shared_ptr<const Model3D> m, shared_ptr<const AnimationSet> a, string w, int h, int s)
+        : model(move(m)), animations(move(a)), weapon(make_shared<Weapon>(Weapon{move(w), 10})),
+          health(h), speed(s) {}
+
+    // Same copy-constructor clone as before — the handles make it shallow
+    Knight* clone() override {
+        return new Knight(*this);
+    }
+
+    // Only the weapon changes: the knight gets its own Weapon, model and animations stay shared
+    void setWeapon(string w) {
+        weapon.reset(make_shared<Weapon>(Weapon{move(w), weapon.read().damage}));
+    }
+
+    // Mutating the model is rare: copy-on-write gives this knight a private model
+    void tintArmor(uint32_t rgb) {
+        model.write().tint = rgb;
+    }
+
+    bool sharesModelWith(const Knight& other) const { return model.sharesWith(other.model); }
+    long modelOwners() const { return model.owners(); }
+
+    void showDetails() override {
+        cout << "Knight => [Model: " << model.read().name
+             << " (" << model.read().vertices.size() << " vertices, tint " << hex << model.read().tint << dec << ")"
+             << ", Weapon: " << weapon.read().name
+             << ", Health: " << health
+             << ", Speed: " << speed << "]" << endl;
+    }
+};
+
+/*
+    🔹 Baseline: the same Knight with assets held by value (clone deep-copies them)
+*/
+class DeepKnight : public Prototype {
+    Model3D model;
+    AnimationSet animations;
+    Weapon weapon;
+    int health;
+    int speed;
+
+public:
+    DeepKnight(const Model3D& m, const AnimationSet& a, string w, int h, int s)
+        : model(m), animations(a), weapon{move(w), 10}, health(h), speed(s) {}
+
+    DeepKnight* clone() override {
+        return new DeepKnight(*this);
+    }
+
+    void setWeapon(string w) { weapon.name = move(w); }
+
+    void showDetails() override {
+        cout << "DeepKnight => [Model: " << model.name << ", Weapon: " << weapon.name << "]" << endl;
+    }
+};
+
+/*
+    🔹 Step 4: Benchmark
+*/
+double residentMB() {
+    long pages = 0, resident = 0;
+    ifstream statm("/proc/self/statm");
+    statm >> pages >> resident;
+    return resident * double(sysconf(_SC_PAGESIZE)) / 1048576.0;
+}
+
+double seconds(chrono::steady_clock::time_point since) {
+    return chrono::duration<double>(chrono::steady_clock::now() - since).count();
+}
+
+int main() {
+    const size_t vertices = 20000;    // ~400 KB mesh
+    const size_t frames = 2000;       // ~3 × 64 KB of animation
+    // Loaded once and immutable from here on: the const is part of the type
+    shared_ptr<const Model3D> mesh = make_shared<Model3D>("Heavy Armor", vertices);
+    shared_ptr<const AnimationSet> anims = make_shared<AnimationSet>(frames);
+
+    Knight* baseKnight = new Knight(mesh, anims, "Sword", 100, 10);
+    cout << "Base Knight Prototype:" << endl;
+    baseKnight->showDetails();
+
+    Knight* knight1 = baseKnight->clone();
+    knight1->setWeapon("Axe");
+    Knight* knight2 = baseKnight->clone();
+    knight2->setWeapon("Bow");
+    knight2->tintArmor(0xaa0000);
+
+    cout << "\nCloned Knights:" << endl;
+    knight1->showDetails();
+    knight2->showDetails();
+    cout << "knight1 shares the model with the prototype: " << (knight1->sharesModelWith(*baseKnight) ? "yes" : "no")
+         << "\nknight2 (tinted) shares it:                  " << (knight2->sharesModelWith(*baseKnight) ? "yes" : "no")
+         << "\n\n";
+    delete knight1;
+    delete knight2;
+
+    // Copy-on-write: 1M clones, every 10th gets a new weapon, every 100000th a new tint
+    const size_t clones = 1000000;
+    long modelCopiesBefore = Model3D::copies;
+    double rssBefore = residentMB();
+    auto start = chrono::steady_clock::now();
+    vector<Knight*> army;
+    army.reserve(clones);
+    for (size_t i = 0; i < clones; i++) {
+        Knight* k = baseKnight->clone();
+        if (i % 10 == 0) k->setWeapon("Axe");
+        if (i % 100000 == 0) k->tintArmor(0x00aa00 + uint32_t(i));
+        army.push_back(k);
+    }
+    double cowTime = seconds(start);
+    double cowRss = residentMB() - rssBefore;
+    cout << "copy-on-write: " << clones << " clones in " << cowTime * 1e3 << " ms, RSS +" << cowRss << " MB\n"
+         << "               model copies: " << Model3D::copies - modelCopiesBefore
+         << ", animation copies: " << AnimationSet::copies
+         << ", prototype model owners: " << baseKnight->modelOwners() << "\n";
+    for (Knight* k : army) delete k;
+    army.clear();
+    army.shrink_to_fit();
+
+    // Deep copy: far fewer clones fit in memory, so measure 2000 and extrapolate
+    const size_t deepClones = 2000;
+    DeepKnight* deepPrototype = new DeepKnight(*mesh, *anims, "Sword", 100, 10);
+    rssBefore = residentMB();
+    start = chrono::steady_clock::now();
+    vector<DeepKnight*> deepArmy;
+    for (size_t i = 0; i < deepClones; i++) {
+        DeepKnight* k = deepPrototype->clone();
+        if (i % 10 == 0) k->setWeapon("Axe");
+        deepArmy.push_back(k);
+    }
+    double deepTime = seconds(start);
+    double deepRss = residentMB() - rssBefore;
+    double scale = double(clones) / deepClones;
+    cout << "deep copy:     " << deepClones << " clones in " << deepTime * 1e3 << " ms, RSS +" << deepRss << " MB"
+         << "\n               → 1M clones would take ~" << deepTime * scale << " s and ~" << deepRss * scale / 1024
+         << " GB\n";
+    for (DeepKnight* k : deepArmy) delete k;
+    delete deepPrototype;
+    delete baseKnight;
+}
+
+/*
+    ✅ Result
+        - A copy-on-write clone is a few pointer copies: 1M knights cost tens of MB
+          (the Knight objects themselves) instead of hundreds of GB of duplicated meshes.
+        - Only what a clone mutates is copied: new weapons allocate a small Weapon,
+          and only the tinted knights own a private model.
+*/
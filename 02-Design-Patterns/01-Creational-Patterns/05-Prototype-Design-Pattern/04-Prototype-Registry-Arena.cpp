@@ -0,0 +1,321 @@
+/*
+    🌊 Prototype Registry + Wave Arena — spawning whole waves of clones
+
+    Spawning a wave with the plain Prototype API looks like:
+        for (...) wave.push_back(baseKnight->clone());   // one new per character
+        ...
+        for (auto* c : wave) delete c;                    // one delete per character
+    Every clone is a separate heap allocation wherever malloc finds room, so iterating
+    the wave jumps around the heap, and tearing it down costs N frees.
+
+    🔹 PrototypeRegistry + WaveArena
+        - The registry owns one preconfigured prototype per archetype ("knight", "wizard", ...)
+          and hands out a small ArchetypeId for the hot path
+        - cloneN(id, n) places n clones CONTIGUOUSLY in a bump arena:
+              one bounds check + pointer bump for the whole batch,
+              each clone is constructed in place by the prototype (cloneInto)
+        - endWave() runs the destructors and rewinds the arena in one go; the arena keeps
+          its memory, so the next wave allocates nothing from the OS or malloc
+
+    Build & run:
+        g++ -std=c++17 -O2 04-Prototype-Registry-Arena.cpp -o registry && ./registry
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <new>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+/*
+    🔹 Step 1: Prototype with an in-place clone
+*/
+class Prototype {
+public:
+    virtual Prototype* clone() const = 0;                  // heap clone (as before)
+    virtual Prototype* cloneInto(void* where) const = 0;   // placement clone into caller memory
+    virtual size_t footprint() const = 0;                  // sizeof the concrete type
+    virtual void update(float dt) = 0;
+    virtual void showDetails() const = 0;
+    virtual ~Prototype() {}
+};
+
+// CRTP helper: the three clone hooks are the same for every concrete character
+template <typename Derived>
+class Cloneable : public Prototype {
+public:
+    Prototype* clone() const override { return new Derived(static_cast<const Derived&>(*this)); }
+    Prototype* cloneInto(void* where) const override {
+        // cloneN places clones at max_align_t strides in max_align_t-aligned blocks
+        static_assert(alignof(Derived) <= alignof(max_align_t), "over-aligned prototypes need their own arena");
+        return new (where) Derived(static_cast<const Derived&>(*this));
+    }
+    size_t footprint() const override { return sizeof(Derived); }
+};
+
+struct Position {
+    float x = 0, y = 0;
+};
+
+class Knight : public Cloneable<Knight> {
+    string model;
+    string weapon;
+    int health;
+    int speed;
+    Position pos;
+
+public:
+    Knight(string m, string w, int h, int s) : model(move(m)), weapon(move(w)), health(h), speed(s) {}
+    void setWeapon(string w) { weapon = move(w); }
+    void update(float dt) override { pos.x += speed * dt; }
+    void showDetails() const override {
+        cout << "Knight => [Model: " << model << ", Weapon: " << weapon << ", Health: " << health
+             << ", Speed: " << speed << ", x: " << pos.x << "]" << endl;
+    }
+};
+
+class Wizard : public Cloneable<Wizard> {
+    string spell;
+    int mana;
+    Position pos;
+    float drift;
+
+public:
+    Wizard(string s, int m, float d) : spell(move(s)), mana(m), drift(d) {}
+    void update(float dt) override { pos.y += drift * dt; mana += 1; }
+    void showDetails() const override {
+        cout << "Wizard => [Spell: " << spell << ", Mana: " << mana << ", y: " << pos.y << "]" << endl;
+    }
+};
+
+class Archer : public Cloneable<Archer> {
+    int arrows;
+    Position pos;
+    Position velocity;
+
+public:
+    Archer(int a, float vx, float vy) : arrows(a) { velocity = {vx, vy}; }
+    void update(float dt) override { pos.x += velocity.x * dt; pos.y += velocity.y * dt; }
+    void showDetails() const override {
+        cout << "Archer => [Arrows: " << arrows << ", x: " << pos.x << ", y: " << pos.y << "]" << endl;
+    }
+};
+
+/*
+    🔹 Step 2: Bump arena for one wave
+*/
+class WaveArena {
+    vector<unique_ptr<char[]>> blocks;
+    size_t blockSize;
+    size_t current = 0;      // block being filled
+    size_t used = 0;         // bytes used in blocks[current]
+
+public:
+    explicit WaveArena(size_t blockSize = 1 << 20) : blockSize(blockSize) {
+        blocks.push_back(make_unique<char[]>(blockSize));
+    }
+
+    void* allocate(size_t bytes, size_t align) {
+        if (bytes > blockSize) throw length_error("allocation larger than an arena block");
+        size_t offset = (used + align - 1) & ~(align - 1);
+        if (offset + bytes > blockSize) {                  // next block (reused from earlier waves if any)
+            if (++current == blocks.size()) blocks.push_back(make_unique<char[]>(blockSize));
+            offset = 0;
+        }
+        used = offset + bytes;
+        return blocks[current].get() + offset;
+    }
+
+    void reset() { current = 0; used = 0; }                 // memory is kept for the next wave
+    size_t blockBytes() const { return blockSize; }
+    size_t reservedBytes() const { return blocks.size() * blockSize; }
+};
+
+/*
+    🔹 Step 3: Contiguous batch of clones
+*/
+// The clones sit side by side in the arena; the span keeps the Prototype* each cloneInto
+// returned (also in the arena), which is right even when Prototype is not at offset 0
+class CloneSpan {
+    Prototype* const* objects;
+    size_t n;
+
+public:
+    CloneSpan(Prototype* const* objects, size_t n) : objects(objects), n(n) {}
+    size_t size() const { return n; }
+    Prototype& operator[](size_t i) const { return *objects[i]; }
+};
+
+/*
+    🔹 Step 4: The registry
+*/
+using ArchetypeId = uint32_t;
+
+class PrototypeRegistry {
+    vector<unique_ptr<Prototype>> prototypes;
+    unordered_map<string, ArchetypeId> ids;
+    WaveArena arena;
+    vector<CloneSpan> wave;              // batches alive in the current wave
+
+    static void destroy(const CloneSpan& span) {
+        for (size_t i = 0; i < span.size(); i++) span[i].~Prototype();
+    }
+
+public:
+    ArchetypeId add(const string& archetype, unique_ptr<Prototype> prototype) {
+        if (ids.count(archetype)) throw invalid_argument("archetype already registered: " + archetype);
+        prototypes.push_back(move(prototype));
+        ArchetypeId id = static_cast<ArchetypeId>(prototypes.size() - 1);
+        ids.emplace(archetype, id);
+        return id;
+    }
+
+    ArchetypeId idOf(const string& archetype) const {
+        auto it = ids.find(archetype);
+        if (it == ids.end()) throw invalid_argument("unknown archetype: " + archetype);
+        return it->second;
+    }
+
+    // n clones of one archetype, side by side in the arena (batches larger than a block are split).
+    // If a clone throws, every clone made by this call is destroyed before rethrowing.
+    vector<CloneSpan> cloneN(ArchetypeId id, size_t n) {
+        const Prototype& proto = *prototypes.at(id);
+        size_t stride = (proto.footprint() + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+        if (stride > arena.blockBytes()) throw length_error("prototype larger than an arena block");
+        size_t perBlock = arena.blockBytes() / stride;
+        size_t waveBefore = wave.size();
+        vector<CloneSpan> spans;
+        for (size_t done = 0; done < n;) {
+            size_t count = min(perBlock, n - done);
+            char* block = static_cast<char*>(arena.allocate(count * stride, alignof(max_align_t)));
+            auto objects = static_cast<Prototype**>(arena.allocate(count * sizeof(Prototype*), alignof(Prototype*)));
+            size_t built = 0;
+            try {
+                for (; built < count; built++) objects[built] = proto.cloneInto(block + built * stride);
+            } catch (...) {
+                for (size_t i = 0; i < built; i++) objects[i]->~Prototype();
+                for (size_t s = waveBefore; s < wave.size(); s++) destroy(wave[s]);
+                wave.erase(wave.begin() + waveBefore, wave.end());
+                throw;
+            }
+            spans.emplace_back(objects, count);
+            wave.push_back(spans.back());
+            done += count;
+        }
+        return spans;
+    }
+
+    vector<CloneSpan> cloneN(const string& archetype, size_t n) { return cloneN(idOf(archetype), n); }
+
+    const vector<CloneSpan>& currentWave() const { return wave; }
+
+    // Destroy every clone of the wave and rewind the arena
+    void endWave() {
+        for (const CloneSpan& span : wave) destroy(span);
+        wave.clear();
+        arena.reset();
+    }
+
+    size_t arenaBytes() const { return arena.reservedBytes(); }
+
+    ~PrototypeRegistry() { endWave(); }
+};
+
+/*
+    🔹 Step 5: Benchmark — spawn a 100k wave, run 10 ticks, tear it down
+*/
+double millis(chrono::steady_clock::time_point since) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - since).count();
+}
+
+struct Timing {
+    double spawn = 0, iterate = 0, teardown = 0;
+};
+
+int main() {
+    PrototypeRegistry registry;
+    ArchetypeId knight = registry.add("knight", make_unique<Knight>("Heavy Armor", "Sword", 100, 10));
+    ArchetypeId wizard = registry.add("wizard", make_unique<Wizard>("Fireball", 50, 1.5f));
+    ArchetypeId archer = registry.add("archer", make_unique<Archer>(30, 2.f, 0.5f));
+
+    // Small demo wave
+    for (const CloneSpan& span : registry.cloneN("knight", 2)) {
+        for (size_t i = 0; i < span.size(); i++) {
+            span[i].update(1.f);
+            span[i].showDetails();
+        }
+    }
+    registry.endWave();
+
+    // Heap-allocated prototypes for the per-object baseline (same objects as the registry's)
+    unique_ptr<Prototype> protos[] = {make_unique<Knight>("Heavy Armor", "Sword", 100, 10),
+                                      make_unique<Wizard>("Fireball", 50, 1.5f),
+                                      make_unique<Archer>(30, 2.f, 0.5f)};
+    ArchetypeId ids[] = {knight, wizard, archer};
+    const size_t perArchetype[] = {50000, 30000, 20000};   // 100k per wave
+    const int waves = 20, ticks = 10;
+
+    // Keep some long-lived objects around, like a real game does, so the heap is not pristine
+    vector<unique_ptr<Prototype>> residents;
+    for (int i = 0; i < 50000; i++) residents.emplace_back(protos[i % 3]->clone());
+    for (size_t i = 0; i < residents.size(); i += 2) residents[i].reset();
+
+    Timing heap, pooled;
+    for (int w = 0; w < waves; w++) {
+        // per-object new/delete
+        auto start = chrono::steady_clock::now();
+        vector<Prototype*> wave;
+        wave.reserve(100000);
+        for (int a = 0; a < 3; a++)
+            for (size_t i = 0; i < perArchetype[a]; i++) wave.push_back(protos[a]->clone());
+        heap.spawn += millis(start);
+
+        start = chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++)
+            for (Prototype* p : wave) p->update(0.016f);
+        heap.iterate += millis(start);
+
+        start = chrono::steady_clock::now();
+        for (Prototype* p : wave) delete p;
+        heap.teardown += millis(start);
+
+        // registry + arena
+        start = chrono::steady_clock::now();
+        for (int a = 0; a < 3; a++) registry.cloneN(ids[a], perArchetype[a]);
+        pooled.spawn += millis(start);
+
+        start = chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++)
+            for (const CloneSpan& span : registry.currentWave())
+                for (size_t i = 0; i < span.size(); i++) span[i].update(0.016f);
+        pooled.iterate += millis(start);
+
+        start = chrono::steady_clock::now();
+        registry.endWave();
+        pooled.teardown += millis(start);
+    }
+
+    cout << "\nper wave of 100k clones (" << ticks << " update ticks), averaged over " << waves << " waves:\n";
+    cout << "  new/delete per object:  spawn " << heap.spawn / waves << " ms\titerate " << heap.iterate / waves
+         << " ms\tteardown " << heap.teardown / waves << " ms\n";
+    cout << "  registry + wave arena:  spawn " << pooled.spawn / waves << " ms\titerate " << pooled.iterate / waves
+         << " ms\tteardown " << pooled.teardown / waves << " ms\n";
+    cout << "  arena reserved: " << registry.arenaBytes() / 1048576 << " MB (reused by every wave)\n";
+}
+
+/*
+    ✅ Result
+        - Spawning costs a pointer bump per batch plus the copy constructors, instead of one
+          malloc per clone.
+        - Clones of one archetype sit next to each other, so update ticks stream through
+          memory instead of chasing pointers around a fragmented heap.
+        - Tearing a wave down is one pass of destructors and a rewind; no free() calls, and
+          the next wave reuses the same memory.
+*/
@@ -0,0 +1,280 @@
+/*
+    🧱 Data-Oriented Entity Store — the Prototype API as a thin facade
+
+    A game tick over Prototype* objects:
+        for (Prototype* p : knights) p->takeDamage(0.1f);   // virtual call + pointer chase
+    Each Knight lives wherever new put it, together with model/weapon strings it does not
+    need for this update. Reading one float of health pulls in a whole cache line of
+    unrelated bytes, and the next knight is somewhere else on the heap.
+
+    🔹 ECS-style store
+        - KnightStore keeps one dense array per component:
+              health[]  speed[]  x[]  weaponId[]
+          index i in every array belongs to the same knight
+        - EntityIds stay stable: a sparse table maps id → dense index, and destroy()
+          swap-removes, so the arrays never have holes. An id carries its slot's
+          generation, so a stale id is rejected instead of reaching a reused slot
+        - Shared, read-mostly data (the model) is stored once per table, weapons are
+          interned to 16-bit ids
+        - Bulk systems are plain loops over arrays → the compiler vectorizes them
+              applyDamage(0.1f)   → health[i] *= 0.9f (respawn below 1 HP)
+              advance(dt)         → x[i] += speed[i] * dt
+        - KnightRef implements Prototype (clone, setWeapon, showDetails) on top of an id and
+          owns its entity (deleting a clone destroys its row), so code written against the
+          Prototype API keeps working
+
+    Build & run:
+        g++ -std=c++17 -O3 05-Entity-Store.cpp -o ecs && ./ecs      (-O3: loop vectorizer on)
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+class Prototype {
+public:
+    virtual Prototype* clone() = 0;
+    virtual void showDetails() = 0;
+    virtual ~Prototype() {}
+};
+
+/*
+    🔹 Baseline: heap Knights behind Prototype* (as in 02-Game-Character-Design.cpp)
+*/
+class HeapKnight : public Prototype {
+    string model;
+    string weapon;
+    float health;
+    float speed;
+    float x = 0;
+
+public:
+    HeapKnight(string m, string w, float h, float s) : model(move(m)), weapon(move(w)), health(h), speed(s) {}
+    HeapKnight* clone() override { return new HeapKnight(*this); }
+    void showDetails() override {
+        cout << "Knight => [Model: " << model << ", Weapon: " << weapon << ", Health: " << health
+             << ", Speed: " << speed << "]" << endl;
+    }
+    virtual void takeDamage(float fraction) { health = health < 1.f ? 100.f : health * (1.f - fraction); }
+    virtual void advance(float dt) { x += speed * dt; }
+    float getHealth() const { return health; }
+};
+
+/*
+    🔹 Step 1: The store
+*/
+// slot = index into the sparse table; generation = how many times that slot was reused
+struct EntityId {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+class KnightStore {
+    static constexpr uint32_t None = UINT32_MAX;
+
+    // Components, dense and index-aligned
+    vector<float> health;
+    vector<float> speed;
+    vector<float> x;
+    vector<uint16_t> weaponId;
+    vector<uint32_t> idOf;              // dense index → slot
+
+    vector<uint32_t> denseOf;           // slot → dense index (None if destroyed)
+    vector<uint32_t> generationOf;      // slot → current generation
+    vector<uint32_t> freeSlots;
+
+    string model;                       // shared by every knight in this table
+    vector<string> weaponNames;
+
+    uint32_t index(EntityId id) const {
+        if (!alive(id)) throw out_of_range("dead entity");
+        return denseOf[id.slot];
+    }
+
+public:
+    explicit KnightStore(string model) : model(move(model)) {}
+
+    void reserve(size_t n) {
+        health.reserve(n); speed.reserve(n); x.reserve(n); weaponId.reserve(n); idOf.reserve(n);
+        denseOf.reserve(n); generationOf.reserve(n);
+    }
+
+    bool alive(EntityId id) const {
+        return id.slot < denseOf.size() && generationOf[id.slot] == id.generation && denseOf[id.slot] != None;
+    }
+
+    uint16_t weapon(const string& name) {
+        for (size_t i = 0; i < weaponNames.size(); i++)
+            if (weaponNames[i] == name) return static_cast<uint16_t>(i);
+        if (weaponNames.size() > UINT16_MAX) throw length_error("more than 65536 weapon names");
+        weaponNames.push_back(name);
+        return static_cast<uint16_t>(weaponNames.size() - 1);
+    }
+
+    EntityId spawn(float h, float s, uint16_t w) {
+        uint32_t slot;
+        if (!freeSlots.empty()) { slot = freeSlots.back(); freeSlots.pop_back(); }
+        else { slot = static_cast<uint32_t>(denseOf.size()); denseOf.push_back(None); generationOf.push_back(0); }
+        denseOf[slot] = static_cast<uint32_t>(health.size());
+        health.push_back(h);
+        speed.push_back(s);
+        x.push_back(0);
+        weaponId.push_back(w);
+        idOf.push_back(slot);
+        return {slot, generationOf[slot]};
+    }
+
+    // Prototype clone = copy one row of components
+    EntityId cloneEntity(EntityId src) {
+        uint32_t i = index(src);
+        EntityId id = spawn(health[i], speed[i], weaponId[i]);
+        x[denseOf[id.slot]] = x[i];
+        return id;
+    }
+
+    void destroy(EntityId id) {
+        uint32_t i = index(id), last = static_cast<uint32_t>(health.size() - 1);
+        health[i] = health[last]; speed[i] = speed[last]; x[i] = x[last]; weaponId[i] = weaponId[last];
+        idOf[i] = idOf[last];
+        denseOf[idOf[i]] = i;
+        health.pop_back(); speed.pop_back(); x.pop_back(); weaponId.pop_back(); idOf.pop_back();
+        denseOf[id.slot] = None;
+        generationOf[id.slot]++;                    // every outstanding id for this slot is now stale
+        freeSlots.push_back(id.slot);
+    }
+
+    void setWeapon(EntityId id, const string& name) { weaponId[index(id)] = weapon(name); }
+
+    void show(EntityId id) const {
+        uint32_t i = index(id);
+        cout << "Knight #" << id.slot << " => [Model: " << model << ", Weapon: " << weaponNames[weaponId[i]]
+             << ", Health: " << health[i] << ", Speed: " << speed[i] << "]" << endl;
+    }
+
+    float healthOf(EntityId id) const { return health[index(id)]; }
+    size_t size() const { return health.size(); }
+
+    /*
+        🔹 Step 2: Systems — linear scans over one or two arrays
+    */
+    // Knights that drop below 1 HP respawn at full health, computed without a branch so the loop vectorizes
+    void applyDamage(float fraction) {
+        float* __restrict h = health.data();
+        const float keep = 1.f - fraction;
+        for (size_t i = 0, n = health.size(); i < n; i++) {
+            float damaged = h[i] * keep;
+            float respawn = float(h[i] < 1.f);                  // 0 or 1, no branch
+            h[i] = damaged + respawn * (100.f - damaged);
+        }
+    }
+
+    void advance(float dt) {
+        float* __restrict px = x.data();
+        const float* __restrict s = speed.data();
+        for (size_t i = 0, n = x.size(); i < n; i++) px[i] += s[i] * dt;
+    }
+};
+
+/*
+    🔹 Step 3: Prototype facade over an entity id
+*/
+// Owns its entity: the row is destroyed with the KnightRef (copy = clone(), not a second owner)
+class KnightRef : public Prototype {
+    KnightStore* store;
+    EntityId id;
+
+public:
+    KnightRef(KnightStore& s, EntityId id) : store(&s), id(id) {}
+    KnightRef(const KnightRef&) = delete;
+    KnightRef& operator=(const KnightRef&) = delete;
+    ~KnightRef() override {
+        if (store->alive(id)) store->destroy(id);
+    }
+
+    KnightRef* clone() override { return new KnightRef(*store, store->cloneEntity(id)); }
+    void showDetails() override { store->show(id); }
+    void setWeapon(const string& w) { store->setWeapon(id, w); }
+    EntityId entity() const { return id; }
+};
+
+/*
+    🔹 Step 4: Benchmark — one tick = 10% damage + movement for every knight
+*/
+double nanosPerEntity(chrono::steady_clock::time_point since, size_t entities, int ticks) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - since).count() / (double(entities) * ticks);
+}
+
+int main() {
+    KnightStore store("Heavy Armor");
+    KnightRef baseKnight(store, store.spawn(100, 10, store.weapon("Sword")));
+    cout << "Base Knight Prototype:" << endl;
+    baseKnight.showDetails();
+
+    unique_ptr<KnightRef> knight1(baseKnight.clone());
+    knight1->setWeapon("Axe");
+    unique_ptr<KnightRef> knight2(baseKnight.clone());
+    knight2->setWeapon("Bow");
+    store.applyDamage(0.1f);
+    cout << "\nCloned Knights (after one 10% damage tick):" << endl;
+    knight1->showDetails();
+    knight2->showDetails();
+    EntityId stale = knight1->entity();
+    knight1.reset();                               // deleting the clone destroys its row
+    cout << "after deleting knight #" << stale.slot << ":" << endl;
+    knight2->showDetails();                        // still valid after the swap-remove
+
+    KnightRef knight3(store, store.spawn(100, 12, store.weapon("Spear")));   // reuses the slot
+    try {
+        store.show(stale);
+    } catch (const out_of_range& e) {
+        cout << "old id for slot #" << knight3.entity().slot << " after reuse: " << e.what() << endl;
+    }
+
+    cout << "\nper-tick cost (10% damage + move), ns per knight:\n";
+    mt19937 rng(5);
+    for (size_t n : {size_t(10000), size_t(100000), size_t(1000000), size_t(10000000)}) {
+        int ticks = int(max<size_t>(3, 50000000 / n));
+
+        // Pointer-chasing layout: heap knights, visited in a shuffled order as after some churn
+        vector<HeapKnight*> heap;
+        heap.reserve(n);
+        HeapKnight prototype("Heavy Armor", "Sword", 100, 10);
+        for (size_t i = 0; i < n; i++) heap.push_back(prototype.clone());
+        shuffle(heap.begin(), heap.end(), rng);
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++)
+            for (HeapKnight* k : heap) { k->takeDamage(0.1f); k->advance(0.016f); }
+        double heapNs = nanosPerEntity(start, n, ticks);
+        float heapCheck = heap.front()->getHealth();
+        for (HeapKnight* k : heap) delete k;
+
+        // Entity store
+        KnightStore knights("Heavy Armor");
+        knights.reserve(n);
+        uint16_t sword = knights.weapon("Sword");
+        EntityId base = knights.spawn(100, 10, sword);
+        for (size_t i = 1; i < n; i++) knights.cloneEntity(base);
+        start = chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) { knights.applyDamage(0.1f); knights.advance(0.016f); }
+        double storeNs = nanosPerEntity(start, n, ticks);
+
+        cout << "  " << n << " knights:\tPrototype* heap " << heapNs << " ns\tKnightStore " << storeNs
+             << " ns\t(x" << heapNs / storeNs << ", health " << heapCheck << " / " << knights.healthOf(base) << ")\n";
+    }
+}
+
+/*
+    ✅ Result
+        - The store touches 12 bytes per knight per tick (health, speed, x) in sequential
+          order; the vectorized loops process several knights per instruction.
+        - The heap layout pays a virtual call and a likely cache miss per knight, and the
+          gap grows once the knights no longer fit in cache.
+        - Prototype-style code (clone, setWeapon, showDetails) still works through KnightRef.
+*/
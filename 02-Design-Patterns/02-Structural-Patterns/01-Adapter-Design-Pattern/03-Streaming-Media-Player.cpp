@@ -0,0 +1,430 @@
+/*
+    🎧 Streaming Media Player — a real playback engine behind the adapters
+
+    In 02-Media-Player.cpp, AudioPlayer::play() looks the player up in MediaAdapterFactory
+    and calls play(fileName) on the caller's thread; Mp3Player and Mp4Adapter only print.
+    Real playback has to read a file, decode it and feed an audio device on a fixed clock,
+    and the device side must never stall (no I/O, no locks, no allocations).
+
+    🔹 Streaming engine (one per play() call)
+        file ──mmap + readahead──▶ decode thread ──SPSC ring of PCM blocks──▶ output thread
+        - Reader:  the file is mmap'ed; MADV_SEQUENTIAL plus MADV_WILLNEED on the window
+                   ahead of the decoder → the kernel reads ahead while we decode
+        - Decoder: dedicated thread; turns compressed frames into 10 ms PCM blocks, writing
+                   straight into preallocated ring slots (waits when the ring is full)
+        - Output:  "device" thread woken every 10 ms; pops one block and copies it into the
+                   device buffer. Never allocates, never locks, never touches the file.
+        - The adapters stay the same shape: Mp3Player decodes itself, Mp4Adapter adapts
+          AdvancedMediaPlayer's incompatible decode call to the FrameDecoder interface.
+
+    Files are synthetic ("FMP3"/"FMP4" containers) written to /tmp and evicted from the page
+    cache before playing, so the first frame includes real disk reads.
+    io_uring would need liburing; mmap + madvise gives the same readahead effect here.
+
+    Reported per stream: startup → first frame latency, underruns, output-thread allocations,
+    and CPU per stream (thread CPU time / playback time).
+
+    Build & run:
+        g++ -std=c++17 -O2 -pthread 03-Streaming-Media-Player.cpp -o streaming && ./streaming
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <time.h>
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/*
+    🔹 Allocation counter per thread (to prove the output thread never allocates)
+*/
+thread_local long threadAllocations = 0;
+
+void* operator new(size_t size) {
+    threadAllocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+double threadCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+    🔹 Step 1: Synthetic container format
+        header: magic[4] + sampleRate(u32)
+        frames: byteCount(u16) + payload → 480 samples (10 ms at 48 kHz, mono)
+*/
+constexpr uint32_t SampleRate = 48000;
+constexpr size_t FrameSamples = 480;
+
+struct PcmBlock {
+    uint32_t samples;
+    int16_t pcm[FrameSamples];
+};
+
+// MP3-like: first sample + 8-bit deltas (lossy "compression")
+// MP4-like: 16-bit samples XOR-scrambled
+void writeSyntheticFile(const string& path, const char magic[4], int seconds) {
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0) throw runtime_error("cannot create " + path);
+    vector<uint8_t> out(magic, magic + 4);
+    out.resize(8);
+    memcpy(out.data() + 4, &SampleRate, 4);
+
+    bool delta = memcmp(magic, "FMP3", 4) == 0;
+    int16_t prev = 0;
+    size_t frames = seconds * SampleRate / FrameSamples;
+    for (size_t f = 0; f < frames; f++) {
+        vector<uint8_t> payload;
+        for (size_t i = 0; i < FrameSamples; i++) {
+            size_t n = f * FrameSamples + i;
+            int16_t s = int16_t(8000 * ((n / 55) % 2 ? 1 : -1) + (n * 37) % 200);   // square-ish tone
+            if (delta) {
+                if (i == 0) { payload.push_back(uint8_t(s)); payload.push_back(uint8_t(s >> 8)); prev = s; }
+                else {
+                    int d = max(-127, min(127, (s - prev) / 128));
+                    payload.push_back(uint8_t(int8_t(d)));
+                    prev = int16_t(prev + d * 128);
+                }
+            } else {
+                uint16_t x = uint16_t(s) ^ 0x5a5a;
+                payload.push_back(uint8_t(x));
+                payload.push_back(uint8_t(x >> 8));
+            }
+        }
+        uint16_t len = uint16_t(payload.size());
+        out.push_back(uint8_t(len));
+        out.push_back(uint8_t(len >> 8));
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    if (::write(fd, out.data(), out.size()) != ssize_t(out.size())) throw runtime_error("short write");
+    fsync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);   // evict → the player starts cold
+    ::close(fd);
+}
+
+/*
+    🔹 Step 2: Decoders — Target interface, Adaptee and Adapter
+*/
+class FrameDecoder {
+public:
+    virtual size_t decode(const uint8_t* frame, size_t bytes, int16_t* pcm) = 0;
+    virtual const char* magic() const = 0;
+    virtual ~FrameDecoder() {}
+};
+
+class Mp3Decoder : public FrameDecoder {
+public:
+    size_t decode(const uint8_t* frame, size_t bytes, int16_t* pcm) override {
+        if (bytes < 2) return 0;                           // no start sample → nothing to decode
+        int16_t s = int16_t(frame[0] | (frame[1] << 8));
+        pcm[0] = s;
+        size_t n = 1;
+        for (size_t i = 2; i < bytes && n < FrameSamples; i++, n++) {
+            s = int16_t(s + int8_t(frame[i]) * 128);
+            pcm[n] = s;
+        }
+        return n;
+    }
+    const char* magic() const override { return "FMP3"; }
+};
+
+// ---- Adaptee (incompatible interface) ----
+class AdvancedMediaPlayer {
+public:
+    // Returns one past the last sample written
+    int16_t* decodeMp4Chunk(const char* data, int length, int16_t* out) {
+        for (int i = 0; i + 1 < length; i += 2) {
+            uint16_t x = uint16_t(uint8_t(data[i]) | (uint8_t(data[i + 1]) << 8)) ^ 0x5a5a;
+            *out++ = int16_t(x);
+        }
+        return out;
+    }
+};
+
+// Adapter converting AdvancedMediaPlayer's decode call to FrameDecoder
+class Mp4DecoderAdapter : public FrameDecoder {
+    AdvancedMediaPlayer advanced;
+public:
+    size_t decode(const uint8_t* frame, size_t bytes, int16_t* pcm) override {
+        int length = int(min(bytes, FrameSamples * 2));
+        return size_t(advanced.decodeMp4Chunk(reinterpret_cast<const char*>(frame), length, pcm) - pcm);
+    }
+    const char* magic() const override { return "FMP4"; }
+};
+
+/*
+    🔹 Step 3: mmap reader with readahead
+*/
+class MappedFile {
+    int fd = -1;
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const string& path) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("cannot open " + path);
+        struct stat st;
+        fstat(fd, &st);
+        length = size_t(st.st_size);
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) { ::close(fd); throw runtime_error("mmap failed: " + path); }
+        base = static_cast<const uint8_t*>(p);
+        madvise(p, length, MADV_SEQUENTIAL);
+    }
+
+    // Ask the kernel to start reading [offset, offset + bytes) in the background
+    void readahead(size_t offset, size_t bytes) const {
+        if (offset >= length) return;
+        size_t page = size_t(sysconf(_SC_PAGESIZE));
+        size_t start = offset & ~(page - 1);
+        size_t end = min(length, offset + bytes);
+        madvise(const_cast<uint8_t*>(base) + start, end - start, MADV_WILLNEED);
+    }
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return length; }
+
+    ~MappedFile() {
+        if (base) munmap(const_cast<uint8_t*>(base), length);
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+/*
+    🔹 Step 4: SPSC ring of PCM blocks (slots preallocated, indices on separate cache lines)
+*/
+template <size_t Slots>
+class PcmRing {
+    array<PcmBlock, Slots> blocks;
+    alignas(64) atomic<size_t> head{0};   // next slot to read  (consumer)
+    alignas(64) atomic<size_t> tail{0};   // next slot to write (producer)
+
+public:
+    PcmBlock* beginWrite() {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == Slots) return nullptr;   // full
+        return &blocks[t % Slots];
+    }
+    void commitWrite() { tail.store(tail.load(memory_order_relaxed) + 1, memory_order_release); }
+
+    const PcmBlock* beginRead() {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) return nullptr;          // empty
+        return &blocks[h % Slots];
+    }
+    void commitRead() { head.store(head.load(memory_order_relaxed) + 1, memory_order_release); }
+};
+
+/*
+    🔹 Step 5: Playback engine
+*/
+struct PlaybackStats {
+    double firstFrameMs = 0;
+    long frames = 0;
+    long underruns = 0;
+    long outputAllocations = 0;
+    double decodeCpu = 0, outputCpu = 0, wall = 0;
+    int64_t checksum = 0;
+};
+
+class StreamingEngine {
+    static constexpr size_t RingSlots = 32;              // 320 ms of audio buffered at most
+    static constexpr size_t ReadaheadBytes = 256 * 1024;
+
+public:
+    static PlaybackStats play(const string& fileName, FrameDecoder& decoder) {
+        auto start = Clock::now();
+        PlaybackStats stats;
+        MappedFile file(fileName);
+        if (file.size() < 8 || memcmp(file.data(), decoder.magic(), 4) != 0)
+            throw runtime_error(fileName + " is not a " + decoder.magic() + " file");
+
+        auto ring = make_unique<PcmRing<RingSlots>>();
+        atomic<bool> decodeDone{false};
+
+        thread decodeThread([&] {
+            double cpu0 = threadCpuSeconds();
+            size_t pos = 8, nextReadahead = 0;
+            while (pos + 2 <= file.size()) {
+                if (pos >= nextReadahead) {                    // keep the kernel one window ahead
+                    file.readahead(pos, 2 * ReadaheadBytes);
+                    nextReadahead = pos + ReadaheadBytes;
+                }
+                size_t bytes = file.data()[pos] | (file.data()[pos + 1] << 8);
+                if (pos + 2 + bytes > file.size()) break;       // truncated frame
+                PcmBlock* block;
+                while (!(block = ring->beginWrite())) this_thread::sleep_for(chrono::milliseconds(2));
+                block->samples = uint32_t(decoder.decode(file.data() + pos + 2, bytes, block->pcm));
+                ring->commitWrite();
+                pos += 2 + bytes;
+            }
+            stats.decodeCpu = threadCpuSeconds() - cpu0;
+            decodeDone = true;
+        });
+
+        thread outputThread([&] {
+            double cpu0 = threadCpuSeconds();
+            long allocs0 = threadAllocations;
+            static thread_local int16_t device[FrameSamples];  // the "sound card" buffer
+            int64_t checksum = 0;
+            long frames = 0, underruns = 0;
+            const auto period = chrono::microseconds(1000000 * FrameSamples / SampleRate);   // 10 ms
+
+            // Pre-roll: wait for the first decoded block, then run on the device clock
+            const PcmBlock* block;
+            while (!(block = ring->beginRead())) this_thread::sleep_for(chrono::microseconds(100));
+            auto deadline = Clock::now();
+            stats.firstFrameMs = chrono::duration<double, milli>(deadline - start).count();
+
+            while (true) {
+                if ((block = ring->beginRead())) {
+                    memcpy(device, block->pcm, block->samples * sizeof(int16_t));
+                    for (uint32_t i = 0; i < block->samples; i += 16) checksum += device[i];
+                    ring->commitRead();
+                    frames++;
+                } else if (decodeDone.load()) {
+                    if (!ring->beginRead()) break;             // drained
+                    continue;
+                } else {
+                    underruns++;                                // device plays silence this period
+                }
+                deadline += period;
+                this_thread::sleep_until(deadline);
+            }
+            stats.frames = frames;
+            stats.underruns = underruns;
+            stats.checksum = checksum;
+            stats.outputAllocations = threadAllocations - allocs0;
+            stats.outputCpu = threadCpuSeconds() - cpu0;
+        });
+
+        decodeThread.join();
+        outputThread.join();
+        stats.wall = chrono::duration<double>(Clock::now() - start).count();
+        return stats;
+    }
+};
+
+/*
+    🔹 Step 6: The original classes, now streaming
+*/
+class MediaPlayer {
+public:
+    virtual PlaybackStats play(const string& fileName) = 0;
+    virtual ~MediaPlayer() {}
+};
+
+class Mp3Player : public MediaPlayer {
+    Mp3Decoder decoder;
+public:
+    PlaybackStats play(const string& fileName) override { return StreamingEngine::play(fileName, decoder); }
+};
+
+class Mp4Adapter : public MediaPlayer {
+    Mp4DecoderAdapter decoder;
+public:
+    PlaybackStats play(const string& fileName) override { return StreamingEngine::play(fileName, decoder); }
+};
+
+class MediaAdapterFactory {
+    map<string, unique_ptr<MediaPlayer>> players;
+public:
+    MediaAdapterFactory() {
+        // Register supported players
+        players["mp3"] = make_unique<Mp3Player>();
+        players["mp4"] = make_unique<Mp4Adapter>();
+    }
+
+    MediaPlayer* getPlayer(const string& type) {
+        auto it = players.find(type);
+        return it != players.end() ? it->second.get() : nullptr;
+    }
+};
+
+class AudioPlayer {
+    MediaAdapterFactory factory;
+public:
+    PlaybackStats play(const string& audioType, const string& fileName) {
+        MediaPlayer* player = factory.getPlayer(audioType);
+        if (!player) throw invalid_argument("Invalid media type: " + audioType);
+        return player->play(fileName);
+    }
+};
+
+void report(const string& label, const PlaybackStats& s) {
+    cout << label << "first frame " << s.firstFrameMs << " ms\t" << s.frames << " frames\tunderruns " << s.underruns
+         << "\toutput allocs " << s.outputAllocations << "\tCPU/stream " << (s.decodeCpu + s.outputCpu) / s.wall * 100
+         << "% (decode " << s.decodeCpu * 1e3 << " ms, output " << s.outputCpu * 1e3 << " ms)\n";
+}
+
+int main() {
+    const int seconds = 3;
+    writeSyntheticFile("/tmp/song.mp3", "FMP3", seconds);
+    writeSyntheticFile("/tmp/video.mp4", "FMP4", seconds);
+
+    AudioPlayer player;
+    report("mp3 (cold cache): ", player.play("mp3", "/tmp/song.mp3"));
+    report("mp4 (cold cache): ", player.play("mp4", "/tmp/video.mp4"));
+    try {
+        player.play("avi", "movie.avi");
+    } catch (const exception& e) {
+        cout << e.what() << "\n";
+    }
+
+    // Several streams at once, each with its own decode + output thread
+    const int streams = 8;
+    for (int i = 0; i < streams; i++)
+        writeSyntheticFile("/tmp/stream" + to_string(i) + (i % 2 ? ".mp4" : ".mp3"), i % 2 ? "FMP4" : "FMP3", seconds);
+    vector<PlaybackStats> results(streams);
+    vector<thread> clients;
+    for (int i = 0; i < streams; i++)
+        clients.emplace_back([&, i] {
+            results[i] = player.play(i % 2 ? "mp4" : "mp3", "/tmp/stream" + to_string(i) + (i % 2 ? ".mp4" : ".mp3"));
+        });
+    for (auto& c : clients) c.join();
+
+    double worstFirst = 0, cpu = 0;
+    long underruns = 0, allocs = 0;
+    for (const PlaybackStats& s : results) {
+        worstFirst = max(worstFirst, s.firstFrameMs);
+        cpu += (s.decodeCpu + s.outputCpu) / s.wall;
+        underruns += s.underruns;
+        allocs += s.outputAllocations;
+    }
+    cout << "\n" << streams << " concurrent streams: worst first frame " << worstFirst << " ms, underruns " << underruns
+         << ", output allocs " << allocs << ", avg CPU/stream " << cpu / streams * 100 << "%\n";
+
+    for (int i = 0; i < streams; i++) remove(("/tmp/stream" + to_string(i) + (i % 2 ? ".mp4" : ".mp3")).c_str());
+    remove("/tmp/song.mp3");
+    remove("/tmp/video.mp4");
+}
+
+/*
+    ✅ Result
+        - First frame arrives after one cold read + one decode, not after the whole file.
+        - The device thread only pops preallocated blocks: 0 allocations, no locks, no I/O,
+          so a slow disk shows up as (buffered) decode delay, not as audible glitches.
+        - Decoding is a tiny fraction of real time, so a stream costs well under 1% of a core.
+*/
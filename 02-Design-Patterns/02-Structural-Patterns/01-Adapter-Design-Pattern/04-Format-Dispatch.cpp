@@ -0,0 +1,339 @@
+/*
+    🎯 Constant-time Format Dispatch for MediaAdapterFactory
+
+    02-Media-Player.cpp dispatches every play() like this:
+        AudioPlayer::play(string audioType, string fileName)      → two string copies
+        players.find(type) != players.end() ... players[type]     → two O(log n) map lookups,
+                                                                      each a chain of string compares
+    With many registered formats that is a lot of work (and allocations) just to find out
+    which adapter to call.
+
+    🔹 Resolve once, dispatch by index
+        - Each registered format gets a dense FormatId (0, 1, 2, ...)
+        - players[FormatId] is a plain array → dispatch is one load + one virtual call
+        - Resolving a format, when needed, is constant time and allocation-free:
+              by extension → the extension is packed into a uint64 (≤ 8 chars, lower-cased)
+                              and looked up in a small open-addressing table
+              by content   → "magic bytes" sniffing: the 4 bytes at offset 0 and at offset 4
+                              (where MP4's "ftyp" lives) are looked up in the same kind of table
+        - The API takes string_view everywhere → no string is built per call
+
+    Build & run:
+        g++ -std=c++17 -O2 04-Format-Dispatch.cpp -o dispatch && ./dispatch
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <memory>
+#include <array>
+#include <stdexcept>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+/*
+    🔹 Allocation counter (every operator new in the program goes through here)
+*/
+static long long allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ---- Target Interface (string_view instead of string by value) ----
+class MediaPlayer {
+public:
+    virtual void play(string_view fileName) = 0;
+    virtual ~MediaPlayer() {}
+};
+
+// ---- Adaptee ----
+class AdvancedMediaPlayer {
+public:
+    long played = 0;
+    void playMp4(string_view fileName) { played += fileName.size(); }
+};
+
+class Mp3Player : public MediaPlayer {
+public:
+    long played = 0;
+    void play(string_view fileName) override { played += fileName.size(); }
+};
+
+class Mp4Adapter : public MediaPlayer {
+    AdvancedMediaPlayer advancedPlayer;
+public:
+    void play(string_view fileName) override { advancedPlayer.playMp4(fileName); }
+};
+
+// Stand-in for the other 48 formats of the benchmark
+class GenericPlayer : public MediaPlayer {
+public:
+    long played = 0;
+    void play(string_view fileName) override { played += fileName.size(); }
+};
+
+/*
+    🔹 Step 1: Small open-addressing table uint64 key → FormatId
+*/
+using FormatId = uint16_t;
+constexpr FormatId UnknownFormat = 0xffff;
+
+class IdTable {
+    static constexpr size_t Size = 256;                  // power of two, ≥ 2 × max formats
+    array<uint64_t, Size> keys{};                        // 0 = empty slot
+    array<FormatId, Size> ids{};
+
+    static size_t slot(uint64_t key) { return size_t((key * 0x9e3779b97f4a7c15ull) >> 56); }
+
+public:
+    static constexpr size_t MaxKeys = Size / 2;          // keeps probe chains short
+
+    void insert(uint64_t key, FormatId id) {
+        if (key == 0) throw invalid_argument("empty key");
+        for (size_t i = slot(key), n = 0; n < Size; i = (i + 1) & (Size - 1), n++) {
+            if (keys[i] == key) throw invalid_argument("key registered twice");
+            if (keys[i] == 0) { keys[i] = key; ids[i] = id; return; }
+        }
+        throw length_error("IdTable full");
+    }
+
+    FormatId find(uint64_t key) const {
+        for (size_t i = slot(key), n = 0; n < Size; i = (i + 1) & (Size - 1), n++) {
+            if (keys[i] == key) return ids[i];
+            if (keys[i] == 0) return UnknownFormat;
+        }
+        return UnknownFormat;
+    }
+};
+
+// "MP3" → 'm','p','3' packed into one integer; longer than 8 chars → 0 (unknown)
+inline uint64_t packExtension(string_view ext) {
+    if (ext.empty() || ext.size() > 8) return 0;
+    uint64_t key = 0;
+    for (size_t i = 0; i < ext.size(); i++) {
+        unsigned char c = ext[i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        key |= uint64_t(c) << (8 * i);
+    }
+    return key;
+}
+
+inline string_view extensionOf(string_view fileName) {
+    size_t dot = fileName.rfind('.');
+    return dot == string_view::npos ? string_view() : fileName.substr(dot + 1);
+}
+
+// Magic key: offset (0 or 4) in the top bits, the 4 bytes below
+inline uint64_t packMagic(size_t offset, const uint8_t* bytes) {
+    uint32_t word;
+    memcpy(&word, bytes, 4);
+    return (uint64_t(offset + 1) << 32) | word;
+}
+
+/*
+    🔹 Step 2: The factory — dense dispatch table + resolvers
+*/
+class MediaAdapterFactory {
+    vector<unique_ptr<MediaPlayer>> players;             // indexed by FormatId
+    vector<string> names;
+    IdTable byExtension;
+    IdTable byMagic;
+
+public:
+    MediaAdapterFactory() {
+        // MP3 files start with an ID3 tag; MP4 files have "ftyp" at offset 4
+        registerFormat("mp3", make_unique<Mp3Player>(), 0, "ID3\x04");
+        registerFormat("mp4", make_unique<Mp4Adapter>(), 4, "ftyp");
+    }
+
+    FormatId registerFormat(string_view extension, unique_ptr<MediaPlayer> player,
+                            size_t magicOffset = 0, string_view magic = {}) {
+        // Validate everything first, so a rejected format leaves no half-registered key behind
+        if (players.size() >= IdTable::MaxKeys) throw length_error("too many formats");
+        uint64_t extensionKey = packExtension(extension);
+        if (extensionKey == 0) throw invalid_argument("extension must be 1-8 characters");
+        if (byExtension.find(extensionKey) != UnknownFormat) throw invalid_argument("extension registered twice");
+        uint64_t magicKey = 0;
+        if (!magic.empty()) {
+            if (magic.size() != 4 || (magicOffset != 0 && magicOffset != 4))
+                throw invalid_argument("magic must be 4 bytes at offset 0 or 4");
+            magicKey = packMagic(magicOffset, reinterpret_cast<const uint8_t*>(magic.data()));
+            if (byMagic.find(magicKey) != UnknownFormat) throw invalid_argument("magic registered twice");
+        }
+
+        FormatId id = FormatId(players.size());
+        byExtension.insert(extensionKey, id);
+        if (magicKey) byMagic.insert(magicKey, id);
+        players.push_back(move(player));
+        names.emplace_back(extension);
+        return id;
+    }
+
+    FormatId fromExtension(string_view type) const { return byExtension.find(packExtension(type)); }
+
+    // Content sniffing: needs the first 8 bytes of the file
+    FormatId sniff(const uint8_t* header, size_t length) const {
+        if (length >= 4) {
+            FormatId id = byMagic.find(packMagic(0, header));
+            if (id != UnknownFormat) return id;
+        }
+        if (length >= 8) return byMagic.find(packMagic(4, header + 4));
+        return UnknownFormat;
+    }
+
+    MediaPlayer* getPlayer(FormatId id) const { return id < players.size() ? players[id].get() : nullptr; }
+    string_view name(FormatId id) const { return id < names.size() ? string_view(names[id]) : "unknown"; }
+};
+
+// ---- Client Class ----
+class AudioPlayer {
+    MediaAdapterFactory factory;
+public:
+    MediaAdapterFactory& formats() { return factory; }
+
+    // Hot path: format resolved once by the caller
+    bool play(FormatId format, string_view fileName) {
+        MediaPlayer* player = factory.getPlayer(format);
+        if (!player) return false;
+        player->play(fileName);
+        return true;
+    }
+
+    // Same call shape as before, without copies
+    bool play(string_view audioType, string_view fileName) { return play(factory.fromExtension(audioType), fileName); }
+
+    // Trust the bytes first, fall back to the file extension
+    bool playFile(string_view fileName, const uint8_t* header, size_t length) {
+        FormatId id = factory.sniff(header, length);
+        if (id == UnknownFormat) id = factory.fromExtension(extensionOf(fileName));
+        return play(id, fileName);
+    }
+};
+
+/*
+    🔹 Baseline: the original map-based factory
+*/
+namespace original {
+
+class MediaPlayer {
+public:
+    virtual void play(string fileName) = 0;
+    virtual ~MediaPlayer() {}
+};
+
+class CountingPlayer : public MediaPlayer {
+public:
+    long played = 0;
+    void play(string fileName) override { played += fileName.size(); }
+};
+
+class MediaAdapterFactory {
+    map<string, MediaPlayer*> players;
+public:
+    void add(const string& type) { players[type] = new CountingPlayer(); }
+
+    MediaPlayer* getPlayer(string type) {
+        if (players.find(type) != players.end()) {
+            return players[type];
+        }
+        return nullptr;
+    }
+
+    ~MediaAdapterFactory() {
+        for (auto& p : players) delete p.second;
+    }
+};
+
+class AudioPlayer {
+public:
+    MediaAdapterFactory factory;
+    bool play(string audioType, string fileName) {
+        MediaPlayer* player = factory.getPlayer(audioType);
+        if (player) player->play(fileName);
+        return player != nullptr;
+    }
+};
+
+} // namespace original
+
+/*
+    🔹 Step 3: Benchmark with 50 registered formats
+*/
+template <typename Run>
+void measure(const string& label, long calls, Run run) {
+    long long before = allocationCount;
+    long hits = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < calls; i++) hits += run(i);
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / calls;
+    cout << label << ns << " ns/play\t" << double(allocationCount - before) / calls << " allocs/play\t(" << hits
+         << " dispatched)\n";
+}
+
+int main() {
+    AudioPlayer player;
+    MediaAdapterFactory& formats = player.formats();
+
+    // 48 more formats: "fmt02".."fmt49" with magic "F#02".."F#49" at offset 0
+    vector<string> extensions = {"mp3", "mp4"};
+    vector<array<uint8_t, 8>> headers = {{'I', 'D', '3', 4, 0, 0, 0, 0}, {0, 0, 0, 24, 'f', 't', 'y', 'p'}};
+    for (int i = 2; i < 50; i++) {
+        string ext = "fmt" + string(i < 10 ? "0" : "") + to_string(i);
+        string magic = "F#" + ext.substr(3);
+        formats.registerFormat(ext, make_unique<GenericPlayer>(), 0, magic);
+        extensions.push_back(ext);
+        headers.push_back({uint8_t(magic[0]), uint8_t(magic[1]), uint8_t(magic[2]), uint8_t(magic[3]), 0, 0, 0, 0});
+    }
+
+    // Demo
+    cout << "song.mp3            → " << formats.name(formats.fromExtension(extensionOf("song.mp3"))) << "\n";
+    cout << "VIDEO.MP4           → " << formats.name(formats.fromExtension(extensionOf("VIDEO.MP4"))) << "\n";
+    cout << "clip.bin (ftyp box) → " << formats.name(formats.sniff(headers[1].data(), 8)) << "\n";
+    cout << "movie.avi           → " << formats.name(formats.fromExtension("avi")) << "\n";
+    try {
+        formats.registerFormat("wav", make_unique<GenericPlayer>(), 2, "WAVE");   // bad offset
+    } catch (const invalid_argument& e) {
+        cout << "register wav: " << e.what() << " → wav is " << formats.name(formats.fromExtension("wav")) << "\n\n";
+    }
+
+    original::AudioPlayer legacy;
+    for (const string& e : extensions) legacy.factory.add(e);
+
+    vector<string> fileNames;
+    for (const string& e : extensions) fileNames.push_back("media_library/track." + e);   // longer than SSO
+    vector<FormatId> resolved;
+    for (const string& e : extensions) resolved.push_back(formats.fromExtension(e));
+
+    const long calls = 10000000;
+    measure("map<string> + by-value strings: ", calls, [&](long i) {
+        return legacy.play(extensions[i % 50], fileNames[i % 50]);
+    });
+    measure("extension → table (string_view): ", calls, [&](long i) {
+        return player.play(string_view(extensions[i % 50]), fileNames[i % 50]);
+    });
+    measure("magic-byte sniffing:             ", calls, [&](long i) {
+        return player.playFile(fileNames[i % 50], headers[i % 50].data(), 8);
+    });
+    measure("pre-resolved FormatId:           ", calls, [&](long i) {
+        return player.play(resolved[i % 50], fileNames[i % 50]);
+    });
+}
+
+/*
+    ✅ Result
+        - The map path copies both strings on every call and walks ~6 string compares twice.
+        - Extension and magic-byte resolution are a few integer ops + one probe, with no
+          allocation; a pre-resolved FormatId is a single array index.
+        - Sniffing picks the right adapter even when the extension lies (clip.bin above).
+*/
@@ -0,0 +1,321 @@
+/*
+    🧾 Batched Draw Commands — a CommandBuffer between Shapes and DrawingAPIs
+
+    In the Bridge examples every Shape::draw() is one virtual call into its DrawingAPI:
+        for (Shape* s : scene) s->draw();   →   api->drawCircle(x, y, r)   (1M shapes = 1M calls)
+    A real GPU API pays far more than a virtual call per draw: state validation, a command
+    header, maybe a pipeline switch when the shape kind changes. With big scenes the per-call
+    overhead, not the drawing, becomes the limit.
+
+    🔹 CommandBuffer
+        - Shapes record() plain parameter structs (CircleCmd, RectCmd, TriangleCmd) instead of
+          calling the API
+        - Records are bucketed by (API, shape kind) as they arrive — a counting sort, O(1) per
+          shape — so submit() hands each API whole batches:
+              api->drawCircles(cmds, n)   one call, one pipeline bind, one packed array
+        - DrawingAPI gets batch entry points with a default that loops over the single-shape
+          calls, so an implementor that knows nothing about batching still works
+        - Sorting changes the submission order across kinds; this suits opaque or depth-tested
+          shapes (the usual case for batching), not painter's-order overlap.
+
+    Backends (all headless):
+        OpenGLAPI / DirectXAPI → write a command stream (header + params per draw) like a driver
+        SoftwareAPI            → bins every shape's bounding box into a coarse tile grid
+
+    Build & run:
+        g++ -std=c++17 -O2 03-Draw-Command-Buffer.cpp -o cmdbuf && ./cmdbuf
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+/*
+    🔹 Step 1: Plain draw parameters
+*/
+enum ShapeKind : uint8_t { CircleKind, RectangleKind, TriangleKind, ShapeKinds };
+
+struct CircleCmd { float x, y, radius; };
+struct RectCmd { float x, y, w, h; };
+struct TriangleCmd { float x0, y0, x1, y1, x2, y2; };
+
+/*
+    🔹 Step 2: Implementor interface with batch entry points
+*/
+class DrawingAPI {
+public:
+    virtual void drawCircle(float x, float y, float radius) = 0;
+    virtual void drawRectangle(float x, float y, float w, float h) = 0;
+    virtual void drawTriangle(float x0, float y0, float x1, float y1, float x2, float y2) = 0;
+
+    // Batches: default = one single-shape call each; backends override to take the whole array
+    virtual void drawCircles(const CircleCmd* c, size_t n) {
+        for (size_t i = 0; i < n; i++) drawCircle(c[i].x, c[i].y, c[i].radius);
+    }
+    virtual void drawRectangles(const RectCmd* r, size_t n) {
+        for (size_t i = 0; i < n; i++) drawRectangle(r[i].x, r[i].y, r[i].w, r[i].h);
+    }
+    virtual void drawTriangles(const TriangleCmd* t, size_t n) {
+        for (size_t i = 0; i < n; i++) drawTriangle(t[i].x0, t[i].y0, t[i].x1, t[i].y1, t[i].x2, t[i].y2);
+    }
+
+    virtual const char* name() const = 0;
+    virtual ~DrawingAPI() {}
+};
+
+/*
+    🔹 Step 3: Headless GPU-style backends — they encode a command stream like a driver
+        immediate draw: [bind pipeline if the kind changed] + [opcode, params...]
+        batched draw:   [bind pipeline if the kind changed] + [opcode, count, params × count]
+*/
+class CommandStreamAPI : public DrawingAPI {
+    vector<float> stream;
+    int boundPipeline = -1;
+
+    void bind(ShapeKind kind) {
+        if (boundPipeline == kind) return;
+        boundPipeline = kind;
+        pipelineSwitches++;
+        stream.push_back(-1.f);                           // "bind pipeline" command
+        stream.push_back(float(kind));
+    }
+
+    template <typename Cmd>
+    void emit(ShapeKind kind, const Cmd* cmds, size_t n) {
+        bind(kind);
+        drawCalls++;
+        stream.push_back(float(kind));
+        stream.push_back(float(n));
+        const float* p = reinterpret_cast<const float*>(cmds);
+        stream.insert(stream.end(), p, p + n * sizeof(Cmd) / sizeof(float));
+    }
+
+public:
+    long drawCalls = 0;
+    long pipelineSwitches = 0;
+
+    void drawCircle(float x, float y, float radius) override {
+        CircleCmd c{x, y, radius};
+        emit(CircleKind, &c, 1);
+    }
+    void drawRectangle(float x, float y, float w, float h) override {
+        RectCmd r{x, y, w, h};
+        emit(RectangleKind, &r, 1);
+    }
+    void drawTriangle(float x0, float y0, float x1, float y1, float x2, float y2) override {
+        TriangleCmd t{x0, y0, x1, y1, x2, y2};
+        emit(TriangleKind, &t, 1);
+    }
+    void drawCircles(const CircleCmd* c, size_t n) override { emit(CircleKind, c, n); }
+    void drawRectangles(const RectCmd* r, size_t n) override { emit(RectangleKind, r, n); }
+    void drawTriangles(const TriangleCmd* t, size_t n) override { emit(TriangleKind, t, n); }
+
+    // End of frame: the stream would be handed to the GPU here
+    size_t present() {
+        size_t bytes = stream.size() * sizeof(float);
+        stream.clear();                                   // keeps capacity for the next frame
+        boundPipeline = -1;
+        return bytes;
+    }
+};
+
+class OpenGLAPI : public CommandStreamAPI {
+public:
+    const char* name() const override { return "OpenGL"; }
+};
+
+class DirectXAPI : public CommandStreamAPI {
+public:
+    const char* name() const override { return "DirectX"; }
+};
+
+// Software backend: bins each shape's bounding box into a 64 × 64 grid of 64-px tiles
+class SoftwareAPI : public DrawingAPI {
+    static constexpr int Tiles = 64, TileSize = 64;
+    array<uint32_t, Tiles * Tiles> binCounts{};
+
+    void bin(float minX, float minY, float maxX, float maxY) {
+        int tx0 = max(0, int(minX) / TileSize), ty0 = max(0, int(minY) / TileSize);
+        int tx1 = min(Tiles - 1, int(maxX) / TileSize), ty1 = min(Tiles - 1, int(maxY) / TileSize);
+        for (int ty = ty0; ty <= ty1; ty++)
+            for (int tx = tx0; tx <= tx1; tx++) binCounts[ty * Tiles + tx]++;
+    }
+    void circle(const CircleCmd& c) { bin(c.x - c.radius, c.y - c.radius, c.x + c.radius, c.y + c.radius); }
+    void rect(const RectCmd& r) { bin(r.x, r.y, r.x + r.w, r.y + r.h); }
+    void triangle(const TriangleCmd& t) {
+        bin(min({t.x0, t.x1, t.x2}), min({t.y0, t.y1, t.y2}), max({t.x0, t.x1, t.x2}), max({t.y0, t.y1, t.y2}));
+    }
+
+public:
+    void drawCircle(float x, float y, float radius) override { circle({x, y, radius}); }
+    void drawRectangle(float x, float y, float w, float h) override { rect({x, y, w, h}); }
+    void drawTriangle(float x0, float y0, float x1, float y1, float x2, float y2) override {
+        triangle({x0, y0, x1, y1, x2, y2});
+    }
+    // Batches: a tight non-virtual loop per kind
+    void drawCircles(const CircleCmd* c, size_t n) override { for (size_t i = 0; i < n; i++) circle(c[i]); }
+    void drawRectangles(const RectCmd* r, size_t n) override { for (size_t i = 0; i < n; i++) rect(r[i]); }
+    void drawTriangles(const TriangleCmd* t, size_t n) override { for (size_t i = 0; i < n; i++) triangle(t[i]); }
+
+    const char* name() const override { return "Software"; }
+    uint64_t binned() const {
+        uint64_t total = 0;
+        for (uint32_t c : binCounts) total += c;
+        return total;
+    }
+    void present() { binCounts.fill(0); }
+};
+
+/*
+    🔹 Step 4: The CommandBuffer
+*/
+class CommandBuffer {
+    struct Batches {
+        DrawingAPI* api;
+        vector<CircleCmd> circles;
+        vector<RectCmd> rectangles;
+        vector<TriangleCmd> triangles;
+    };
+    vector<Batches> perApi;                               // a handful of APIs → linear scan
+    DrawingAPI* lastApi = nullptr;
+    Batches* lastBatches = nullptr;
+
+    Batches& batchesFor(DrawingAPI* api) {
+        if (api == lastApi) return *lastBatches;
+        for (auto& b : perApi)
+            if (b.api == api) { lastApi = api; lastBatches = &b; return b; }
+        perApi.push_back({api, {}, {}, {}});
+        lastApi = nullptr;                                // push_back may move the other entries
+        return perApi.back();
+    }
+
+public:
+    void record(DrawingAPI* api, const CircleCmd& c) { batchesFor(api).circles.push_back(c); }
+    void record(DrawingAPI* api, const RectCmd& r) { batchesFor(api).rectangles.push_back(r); }
+    void record(DrawingAPI* api, const TriangleCmd& t) { batchesFor(api).triangles.push_back(t); }
+
+    // One call per (API, kind); buckets are emptied but keep their capacity
+    void submit() {
+        for (auto& b : perApi) {
+            if (!b.circles.empty()) b.api->drawCircles(b.circles.data(), b.circles.size());
+            if (!b.rectangles.empty()) b.api->drawRectangles(b.rectangles.data(), b.rectangles.size());
+            if (!b.triangles.empty()) b.api->drawTriangles(b.triangles.data(), b.triangles.size());
+            b.circles.clear();
+            b.rectangles.clear();
+            b.triangles.clear();
+        }
+    }
+};
+
+/*
+    🔹 Step 5: Shapes — draw() immediately, or record() into a CommandBuffer
+*/
+class Shape {
+protected:
+    DrawingAPI* drawingAPI;   // Bridge link
+public:
+    Shape(DrawingAPI* api) : drawingAPI(api) {}
+    virtual void draw() = 0;
+    virtual void record(CommandBuffer& buffer) = 0;
+    virtual ~Shape() {}
+};
+
+class Circle : public Shape {
+    CircleCmd c;
+public:
+    Circle(float x, float y, float r, DrawingAPI* api) : Shape(api), c{x, y, r} {}
+    void draw() override { drawingAPI->drawCircle(c.x, c.y, c.radius); }
+    void record(CommandBuffer& buffer) override { buffer.record(drawingAPI, c); }
+};
+
+class Rectangle : public Shape {
+    RectCmd r;
+public:
+    Rectangle(float x, float y, float w, float h, DrawingAPI* api) : Shape(api), r{x, y, w, h} {}
+    void draw() override { drawingAPI->drawRectangle(r.x, r.y, r.w, r.h); }
+    void record(CommandBuffer& buffer) override { buffer.record(drawingAPI, r); }
+};
+
+class Triangle : public Shape {
+    TriangleCmd t;
+public:
+    Triangle(float x0, float y0, float x1, float y1, float x2, float y2, DrawingAPI* api)
+        : Shape(api), t{x0, y0, x1, y1, x2, y2} {}
+    void draw() override { drawingAPI->drawTriangle(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2); }
+    void record(CommandBuffer& buffer) override { buffer.record(drawingAPI, t); }
+};
+
+/*
+    🔹 Step 6: Benchmark — 1M mixed shapes per frame
+*/
+int main() {
+    OpenGLAPI opengl;
+    DirectXAPI directx;
+    SoftwareAPI software;
+    DrawingAPI* apis[] = {&opengl, &directx, &software};
+
+    const size_t shapes = 1000000;
+    vector<unique_ptr<Shape>> scene;
+    scene.reserve(shapes);
+    mt19937 rng(11);
+    uniform_real_distribution<float> pos(0, 4096), size(2, 40);
+    for (size_t i = 0; i < shapes; i++) {
+        DrawingAPI* api = apis[rng() % 3];
+        float x = pos(rng), y = pos(rng), s = size(rng);
+        switch (rng() % 3) {
+            case 0: scene.push_back(make_unique<Circle>(x, y, s, api)); break;
+            case 1: scene.push_back(make_unique<Rectangle>(x, y, s, s * 0.5f, api)); break;
+            default: scene.push_back(make_unique<Triangle>(x, y, x + s, y, x, y + s, api)); break;
+        }
+    }
+
+    const int frames = 10;
+    auto frameStats = [&](const char* label, double ms) {
+        size_t glBytes = opengl.present(), dxBytes = directx.present();
+        cout << label << ms / frames << " ms/frame\tdraw calls GL " << opengl.drawCalls / frames << " DX "
+             << directx.drawCalls / frames << "\tpipeline switches " << (opengl.pipelineSwitches + directx.pipelineSwitches) / frames
+             << "\tstream " << (glBytes + dxBytes) / 1048576.0 << " MB\tbinned " << software.binned() << "\n";
+        opengl.drawCalls = directx.drawCalls = opengl.pipelineSwitches = directx.pipelineSwitches = 0;
+        software.present();
+    };
+
+    // Immediate: one virtual draw per shape
+    double total = 0;
+    for (int f = 0; f < frames; f++) {
+        if (f) { opengl.present(); directx.present(); software.present(); }
+        auto start = chrono::steady_clock::now();
+        for (auto& s : scene) s->draw();
+        total += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    frameStats("immediate: ", total);
+
+    // Batched: record everything, submit once per (API, kind)
+    CommandBuffer buffer;
+    total = 0;
+    for (int f = 0; f < frames; f++) {
+        if (f) { opengl.present(); directx.present(); software.present(); }
+        auto start = chrono::steady_clock::now();
+        for (auto& s : scene) s->record(buffer);
+        buffer.submit();
+        total += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    frameStats("batched:   ", total);
+}
+
+/*
+    ✅ Result
+        - Immediate mode: ~333k draw calls per GPU-style API per frame, a pipeline switch on
+          most of them, and a command header per shape.
+        - Batched mode: 3 draw calls and at most 3 pipeline binds per API per frame; the
+          parameters go to the backend as packed arrays, and the command stream shrinks.
+        - The headless backends charge almost nothing per call, so frame time only drops a
+          little here (recording is still one virtual call per shape). A real driver charges
+          microseconds per draw call, and that cost goes from ~333k per frame to 3.
+*/